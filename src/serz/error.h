@@ -0,0 +1,324 @@
+/**
+ * Contains the structured error of parsing DOM values, which is only
+ * formatted into a message when asked for.
+ * @author Chen Weiguang
+ * @version 0.1.0
+ */
+
+#pragma once
+
+#include "str_ref.h"
+#include "val.h"
+
+#include "rustfp/result.h"
+
+#ifndef FMT_HEADER_ONLY
+#define FMT_HEADER_ONLY
+#endif
+#include "fmt/format.h"
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace serz {
+    // declaration section
+
+    /**
+     * Reason of a parsing failure.
+     */
+    enum class parse_errc {
+        /** Failure described only by its message, e.g. from a custom parse_value. */
+        custom,
+
+        /** DOM value is not of the expected type. */
+        type_mismatch,
+
+        /** Number does not fit into the type being parsed into. */
+        out_of_range,
+
+        /** DOM value is of the expected type, but its content cannot be converted. */
+        invalid_value,
+
+        /** Key is not in the DOM object. */
+        missing_key,
+    };
+
+    /**
+     * Step of the path to a failing value, which is either the key of a DOM
+     * object or the position in a DOM array.
+     */
+    struct parse_path_segment {
+        /**
+         * Key of the DOM object.
+         */
+        std::string key;
+
+        /**
+         * Position in the DOM array.
+         */
+        size_t index;
+
+        /**
+         * Whether the segment is a position rather than a key.
+         */
+        bool is_index;
+    };
+
+    /**
+     * Describes the failure of parsing a DOM value. Creating one allocates
+     * nothing, and each level that the failure propagates out of only appends
+     * its key or position to the path, so that failures which are recovered
+     * from stay cheap. The path and message are only formatted when asked for.
+     */
+    struct parse_error {
+        /**
+         * Initializes the error with the given reason and types.
+         */
+        parse_error(
+            const parse_errc code,
+            const dom_val_type expected,
+            const dom_val_type actual,
+            std::string (*const type_name)() = nullptr);
+
+        /**
+         * Initializes the error with a custom message.
+         */
+        explicit parse_error(std::string message);
+
+        /**
+         * Prefixes the path with the given key of a DOM object.
+         */
+        auto prepend_key(const str_ref &key) -> parse_error &;
+
+        /**
+         * Prefixes the path with the given position in a DOM array.
+         */
+        auto prepend_index(const size_t index) -> parse_error &;
+
+        /**
+         * Formats the path as JSON pointer to the failing value from the value
+         * being parsed, e.g. /orders/17/price.
+         */
+        auto path() const -> std::string;
+
+        /**
+         * Formats the failure into a single line error message.
+         */
+        auto to_string() const -> std::string;
+
+        /**
+         * Reason of the failure.
+         */
+        parse_errc code;
+
+        /**
+         * Type of DOM value that was expected.
+         */
+        dom_val_type expected;
+
+        /**
+         * Type of DOM value that was found.
+         */
+        dom_val_type actual;
+
+        /**
+         * Gets the name of the type being parsed into, or nullptr if not known.
+         */
+        std::string (*type_name)();
+
+        /**
+         * Segments of the path to the failing value, from the failing value
+         * out to the value being parsed.
+         */
+        std::vector<parse_path_segment> segments;
+
+        /**
+         * Message of a custom failure.
+         */
+        std::string message;
+    };
+
+    namespace details {
+        /**
+         * Gets the name of the type of DOM value for error messages.
+         */
+        auto dom_val_type_name(const dom_val_type type) -> const char *;
+
+        /**
+         * Takes the result of parse_value as it is.
+         */
+        template <class T>
+        auto as_parse_result(::rustfp::Result<T, parse_error> &&res) -> ::rustfp::Result<T, parse_error>;
+
+        /**
+         * Takes the result of a custom parse_value that fails with a plain message.
+         */
+        template <class T>
+        auto as_parse_result(::rustfp::Result<T, std::string> &&res) -> ::rustfp::Result<T, parse_error>;
+    }
+
+    /**
+     * Result of the parse_value provided for a type, which can also be returned
+     * from a custom parse_value that fails with a plain message, in which case
+     * the failure is formatted into its message.
+     */
+    template <class T>
+    class parse_result : public ::rustfp::Result<T &, parse_error> {
+    public:
+        /**
+         * Initializes from anything that initializes the underlying result.
+         */
+        template <class Res, class = std::enable_if_t<
+            std::is_constructible<::rustfp::Result<T &, parse_error>, Res &&>::value>>
+        parse_result(Res &&res);
+
+        /**
+         * Formats the failure into its message.
+         */
+        operator ::rustfp::Result<T &, std::string>() &&;
+    };
+
+    // implementation section
+
+    inline parse_error::parse_error(
+        const parse_errc code,
+        const dom_val_type expected,
+        const dom_val_type actual,
+        std::string (*const type_name)()) :
+
+        code(code),
+        expected(expected),
+        actual(actual),
+        type_name(type_name) {
+
+    }
+
+    inline parse_error::parse_error(std::string message) :
+        code(parse_errc::custom),
+        expected(dom_val_type::null_type),
+        actual(dom_val_type::null_type),
+        type_name(nullptr),
+        message(std::move(message)) {
+
+    }
+
+    inline auto parse_error::prepend_key(const str_ref &key) -> parse_error & {
+        // segments are kept from the failing value outwards, so prefixing appends
+        segments.push_back(parse_path_segment{ key.to_string(), 0, false });
+        return *this;
+    }
+
+    inline auto parse_error::prepend_index(const size_t index) -> parse_error & {
+        segments.push_back(parse_path_segment{ std::string(), index, true });
+        return *this;
+    }
+
+    inline auto parse_error::path() const -> std::string {
+        std::string path;
+
+        for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+            path.push_back('/');
+
+            if (it->is_index) {
+                path.append(std::to_string(it->index));
+                continue;
+            }
+
+            // escapes as in JSON pointer
+            for (const char c : it->key) {
+                if (c == '~') {
+                    path.append("~0");
+                } else if (c == '/') {
+                    path.append("~1");
+                } else {
+                    path.push_back(c);
+                }
+            }
+        }
+
+        return path;
+    }
+
+    inline auto parse_error::to_string() const -> std::string {
+        std::string err_msg;
+
+        switch (code) {
+        case parse_errc::custom:
+            err_msg = message;
+            break;
+
+        case parse_errc::type_mismatch:
+            err_msg = fmt::format("Unable to interpret the DOM value of type '{}' as {}",
+                details::dom_val_type_name(actual), details::dom_val_type_name(expected));
+            break;
+
+        case parse_errc::out_of_range:
+            err_msg = fmt::format("Value of type '{}' is out of range",
+                details::dom_val_type_name(actual));
+            break;
+
+        case parse_errc::invalid_value:
+            err_msg = fmt::format("Unable to convert the DOM value of type '{}' to {}",
+                details::dom_val_type_name(actual), details::dom_val_type_name(expected));
+            break;
+
+        case parse_errc::missing_key:
+            err_msg = fmt::format("Unable to find key with name '{}' while performing parse_nvp",
+                segments.empty() ? std::string() : segments.front().key);
+            break;
+        }
+
+        if (type_name != nullptr) {
+            err_msg += fmt::format(" for parsing of '{}'", type_name());
+        }
+
+        if (!segments.empty()) {
+            err_msg += fmt::format(" at '{}'", path());
+        }
+
+        return err_msg;
+    }
+
+    namespace details {
+        inline auto dom_val_type_name(const dom_val_type type) -> const char * {
+            switch (type) {
+            case dom_val_type::null_type: return "null";
+            case dom_val_type::obj_type: return "object";
+            case dom_val_type::arr_type: return "array";
+            case dom_val_type::bool_type: return "bool";
+            case dom_val_type::int_type: return "int";
+            case dom_val_type::flt_type: return "float";
+            case dom_val_type::str_type: return "string";
+            case dom_val_type::null_string_obj_type: return "null string object";
+            }
+
+            return "unknown";
+        }
+
+        template <class T>
+        auto as_parse_result(::rustfp::Result<T, parse_error> &&res) -> ::rustfp::Result<T, parse_error> {
+            return std::move(res);
+        }
+
+        template <class T>
+        auto as_parse_result(::rustfp::Result<T, std::string> &&res) -> ::rustfp::Result<T, parse_error> {
+            return std::move(res).map_err([](std::string err_msg) { return parse_error(std::move(err_msg)); });
+        }
+    }
+
+    template <class T>
+    template <class Res, class>
+    parse_result<T>::parse_result(Res &&res) :
+        ::rustfp::Result<T &, parse_error>(std::forward<Res>(res)) {
+
+    }
+
+    template <class T>
+    parse_result<T>::operator ::rustfp::Result<T &, std::string>() && {
+        return static_cast<::rustfp::Result<T &, parse_error> &&>(*this)
+            .map_err([](const parse_error &err) { return err.to_string(); });
+    }
+}
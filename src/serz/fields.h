@@ -0,0 +1,434 @@
+/**
+ * Contains the SERZ_FIELDS descriptor, which generates the parsing and
+ * serialization of a plain struct from a single table of its fields.
+ * @author Chen Weiguang
+ * @version 0.1.0
+ */
+
+#pragma once
+
+#include "error.h"
+#include "sax.h"
+#include "serialization.h"
+#include "str_ref.h"
+#include "val.h"
+
+#include "rustfp/result.h"
+#include "rustfp/unit.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <utility>
+
+/**
+ * Describes the fields of a struct, which are looked up by the same names
+ * as the members. Generates parse_value, serialize_value and parse_fields
+ * for the struct, so that DOM parsing, SAX parsing and serialization all
+ * follow the one table. Must be placed in the namespace of the struct, and
+ * takes between 1 and 32 fields, e.g. SERZ_FIELDS(X, x, y, z, a).
+ */
+#define SERZ_FIELDS(Type, ...) \
+    constexpr auto serz_fields_of(const Type *) { \
+        return ::std::make_tuple(SERZ_DETAILS_FOR_EACH(SERZ_DETAILS_FIELD, Type, __VA_ARGS__)); \
+    } \
+    \
+    inline auto parse_value(Type &ser, const ::serz::dom_val &val) -> \
+        ::serz::parse_result<Type> { \
+        \
+        return ::serz::details::parse_fields_value(ser, val); \
+    } \
+    \
+    inline auto serialize_value(const Type &ser, ::serz::dom_val &val) -> ::serz::dom_val & { \
+        return ::serz::details::serialize_fields_value(ser, val); \
+    } \
+    \
+    inline auto parse_fields(Type &ser, ::serz::sax_fields &fields) -> ::serz::sax_fields & { \
+        return ::serz::details::add_sax_fields(ser, fields); \
+    }
+
+#define SERZ_DETAILS_FIELD(Type, field) ::serz::details::make_field_desc(#field, &Type::field)
+
+// the extra expansions are needed for MSVC to split __VA_ARGS__
+#define SERZ_DETAILS_EXPAND(x) x
+#define SERZ_DETAILS_CONCAT(lhs, rhs) SERZ_DETAILS_CONCAT_IMPL(lhs, rhs)
+#define SERZ_DETAILS_CONCAT_IMPL(lhs, rhs) lhs##rhs
+
+#define SERZ_DETAILS_COUNT_N( \
+    _1, _2, _3, _4, _5, _6, _7, _8, \
+    _9, _10, _11, _12, _13, _14, _15, _16, \
+    _17, _18, _19, _20, _21, _22, _23, _24, \
+    _25, _26, _27, _28, _29, _30, _31, _32, N, ...) N
+#define SERZ_DETAILS_COUNT(...) \
+    SERZ_DETAILS_EXPAND(SERZ_DETAILS_COUNT_N(__VA_ARGS__, \
+        32, 31, 30, 29, 28, 27, 26, 25, \
+        24, 23, 22, 21, 20, 19, 18, 17, \
+        16, 15, 14, 13, 12, 11, 10, 9, \
+        8, 7, 6, 5, 4, 3, 2, 1))
+
+#define SERZ_DETAILS_FOR_EACH(m, t, ...) \
+    SERZ_DETAILS_EXPAND(SERZ_DETAILS_CONCAT(SERZ_DETAILS_FOR_EACH_, SERZ_DETAILS_COUNT(__VA_ARGS__))(m, t, __VA_ARGS__))
+
+#define SERZ_DETAILS_FOR_EACH_1(m, t, x) m(t, x)
+#define SERZ_DETAILS_FOR_EACH_2(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_1(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_3(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_2(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_4(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_3(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_5(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_4(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_6(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_5(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_7(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_6(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_8(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_7(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_9(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_8(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_10(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_9(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_11(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_10(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_12(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_11(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_13(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_12(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_14(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_13(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_15(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_14(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_16(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_15(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_17(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_16(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_18(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_17(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_19(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_18(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_20(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_19(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_21(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_20(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_22(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_21(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_23(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_22(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_24(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_23(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_25(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_24(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_26(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_25(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_27(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_26(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_28(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_27(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_29(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_28(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_30(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_29(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_31(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_30(m, t, __VA_ARGS__))
+#define SERZ_DETAILS_FOR_EACH_32(m, t, x, ...) m(t, x), SERZ_DETAILS_EXPAND(SERZ_DETAILS_FOR_EACH_31(m, t, __VA_ARGS__))
+
+namespace serz {
+    // declaration section
+
+    namespace details {
+        /**
+         * Name and member pointer of a field described by SERZ_FIELDS.
+         */
+        template <class Ser, class Field>
+        struct field_desc {
+            const char *name;
+            size_t len;
+            Field Ser::*member;
+        };
+
+        /**
+         * Creates the description of a field from its name and member pointer.
+         */
+        template <size_t L, class Ser, class Field>
+        constexpr auto make_field_desc(const char (&name)[L], Field Ser::*member) -> field_desc<Ser, Field>;
+
+        /**
+         * Name of a field, as kept in the perfect hash.
+         */
+        struct field_name {
+            const char *str;
+            size_t len;
+        };
+
+        /**
+         * Perfect hash over the field names of a struct, found at compile time,
+         * so that the field of a key is found with one hash and one comparison.
+         */
+        template <size_t N>
+        struct field_hash {
+            /** Number of slots, which is kept sparse so that a seed is found quickly. */
+            static constexpr size_t SLOT_COUNT = N <= 4 ? 16 : N <= 8 ? 32 : N <= 16 ? 64 : 128;
+
+            /**
+             * Gets the position of the field with the given name, or N if there is no such field.
+             */
+            auto find(const char key[], const size_t len) const -> size_t;
+
+            /**
+             * Seed that maps every name to its own slot, or 0 if none was found.
+             */
+            uint32_t seed;
+
+            /**
+             * Names of the fields in the order of declaration.
+             */
+            field_name names[N];
+
+            /**
+             * Position of the field plus one for each slot, or 0 if the slot is empty.
+             */
+            uint8_t slots[SLOT_COUNT];
+        };
+
+        /**
+         * Hashes the characters of a field name with the given seed.
+         */
+        constexpr auto hash_field_name(const char str[], const size_t len, const uint32_t seed) -> uint32_t;
+
+        /**
+         * Searches for a seed that maps the field names into distinct slots.
+         * Gives a zero seed if the names are not distinct.
+         */
+        template <class Fields, size_t... Is>
+        constexpr auto make_field_hash(const Fields &fields, std::index_sequence<Is...>) ->
+            field_hash<sizeof...(Is)>;
+
+        /**
+         * Holds the field table of a struct described by SERZ_FIELDS and its perfect hash.
+         */
+        template <class Ser>
+        struct field_index {
+            using fields_type = decltype(serz_fields_of(static_cast<const Ser *>(nullptr)));
+
+            static constexpr size_t COUNT = std::tuple_size<fields_type>::value;
+
+            static constexpr fields_type fields = serz_fields_of(static_cast<const Ser *>(nullptr));
+
+            static constexpr field_hash<COUNT> hash =
+                make_field_hash(fields, std::make_index_sequence<COUNT>());
+
+            static_assert(hash.seed != 0, "SERZ_FIELDS requires distinct field names");
+        };
+
+        /**
+         * Gets the name of the field at the given position.
+         */
+        template <class Ser, size_t I>
+        auto get_field_name() -> str_ref;
+
+        /**
+         * Parses the DOM value into the field at the given position.
+         */
+        template <class Ser, size_t I>
+        auto parse_field(Ser &ser, const dom_val &val) -> ::rustfp::Result<::rustfp::unit_t, parse_error>;
+
+        /**
+         * Handles the field at the given position being absent from the DOM object,
+         * in the same way as parse_nvp.
+         */
+        template <class Ser, size_t I>
+        auto parse_missing_field(Ser &ser, const dom_obj &obj) -> ::rustfp::Result<::rustfp::unit_t, parse_error>;
+
+        /**
+         * Parses the members of the DOM object in one pass, jumping to the
+         * field of each member through the perfect hash.
+         */
+        template <class Ser, size_t... Is>
+        auto parse_fields_obj(Ser &ser, const dom_obj &obj, std::index_sequence<Is...>) ->
+            ::rustfp::Result<Ser &, parse_error>;
+
+        /**
+         * Parses the DOM value as a DOM object into the described fields.
+         */
+        template <class Ser>
+        auto parse_fields_value(Ser &ser, const dom_val &val) -> ::rustfp::Result<Ser &, parse_error>;
+
+        /**
+         * Serializes the described fields into the DOM object in the order of declaration.
+         */
+        template <class Ser, size_t... Is>
+        void serialize_fields_obj(const Ser &ser, dom_obj &obj, std::index_sequence<Is...>);
+
+        /**
+         * Serializes the described fields into the DOM value as a DOM object.
+         */
+        template <class Ser>
+        auto serialize_fields_value(const Ser &ser, dom_val &val) -> dom_val &;
+
+        /**
+         * Adds the described fields to the field table for SAX parsing.
+         */
+        template <class Ser, size_t... Is>
+        auto add_sax_fields(Ser &ser, sax_fields &fields, std::index_sequence<Is...>) -> sax_fields &;
+
+        /**
+         * Same as above add_sax_fields, except adds all the described fields.
+         */
+        template <class Ser>
+        auto add_sax_fields(Ser &ser, sax_fields &fields) -> sax_fields &;
+    }
+
+    // implementation section
+
+    namespace details {
+        template <size_t L, class Ser, class Field>
+        constexpr auto make_field_desc(const char (&name)[L], Field Ser::*member) -> field_desc<Ser, Field> {
+            return field_desc<Ser, Field>{name, L - 1, member};
+        }
+
+        template <size_t N>
+        constexpr size_t field_hash<N>::SLOT_COUNT;
+
+        template <size_t N>
+        auto field_hash<N>::find(const char key[], const size_t len) const -> size_t {
+            const auto slot = slots[hash_field_name(key, len, seed) & (SLOT_COUNT - 1)];
+
+            if (slot == 0) {
+                return N;
+            }
+
+            const auto &name = names[slot - 1];
+
+            return name.len == len && std::memcmp(name.str, key, len) == 0
+                ? static_cast<size_t>(slot - 1)
+                : N;
+        }
+
+        constexpr auto hash_field_name(const char str[], const size_t len, const uint32_t seed) -> uint32_t {
+            // FNV-1a from a seeded basis, then mixed so that the low bits pick the slot
+            uint32_t hash = 2166136261u ^ (seed * 2654435769u);
+
+            for (size_t i = 0; i < len; ++i) {
+                hash = (hash ^ static_cast<unsigned char>(str[i])) * 16777619u;
+            }
+
+            hash ^= hash >> 16;
+            hash *= 2246822507u;
+            hash ^= hash >> 13;
+            return hash;
+        }
+
+        template <class Fields, size_t... Is>
+        constexpr auto make_field_hash(const Fields &fields, std::index_sequence<Is...>) ->
+            field_hash<sizeof...(Is)> {
+
+            constexpr size_t N = sizeof...(Is);
+            const field_name names[] = {{std::get<Is>(fields).name, std::get<Is>(fields).len}...};
+
+            // an expected seed is found within a few tries, so running out means duplicates
+            for (uint32_t seed = 1; seed <= 4096; ++seed) {
+                field_hash<N> hash{};
+                hash.seed = seed;
+                bool collided = false;
+
+                for (size_t index = 0; index < N && !collided; ++index) {
+                    hash.names[index].str = names[index].str;
+                    hash.names[index].len = names[index].len;
+
+                    auto &slot = hash.slots[hash_field_name(names[index].str, names[index].len, seed) &
+                        (field_hash<N>::SLOT_COUNT - 1)];
+
+                    collided = slot != 0;
+                    slot = static_cast<uint8_t>(index + 1);
+                }
+
+                if (!collided) {
+                    return hash;
+                }
+            }
+
+            return field_hash<N>{};
+        }
+
+        template <class Ser>
+        constexpr size_t field_index<Ser>::COUNT;
+
+        template <class Ser>
+        constexpr typename field_index<Ser>::fields_type field_index<Ser>::fields;
+
+        template <class Ser>
+        constexpr field_hash<field_index<Ser>::COUNT> field_index<Ser>::hash;
+
+        template <class Ser, size_t I>
+        auto get_field_name() -> str_ref {
+            const auto &field = std::get<I>(field_index<Ser>::fields);
+            return str_ref(field.name, field.len);
+        }
+
+        template <class Ser, size_t I>
+        auto parse_field(Ser &ser, const dom_val &val) -> ::rustfp::Result<::rustfp::unit_t, parse_error> {
+            return as_parse_result(parse_value(ser.*std::get<I>(field_index<Ser>::fields).member, val))
+                .map([](auto &) { return ::rustfp::Unit; })
+                .map_err([](parse_error err) { return std::move(err.prepend_key(get_field_name<Ser, I>())); });
+        }
+
+        template <class Ser, size_t I>
+        auto parse_missing_field(Ser &ser, const dom_obj &obj) -> ::rustfp::Result<::rustfp::unit_t, parse_error> {
+            return parse_nvp(ser.*std::get<I>(field_index<Ser>::fields).member, get_field_name<Ser, I>())(
+                ::rustfp::Result<dom_obj_cursor, parse_error>(::rustfp::Ok(dom_obj_cursor(obj))))
+                .map([](const dom_obj_cursor &) { return ::rustfp::Unit; });
+        }
+
+        template <class Ser, size_t... Is>
+        auto parse_fields_obj(Ser &ser, const dom_obj &obj, std::index_sequence<Is...>) ->
+            ::rustfp::Result<Ser &, parse_error> {
+
+            using parse_fn = auto (*)(Ser &, const dom_val &) -> ::rustfp::Result<::rustfp::unit_t, parse_error>;
+            using missing_fn = auto (*)(Ser &, const dom_obj &) -> ::rustfp::Result<::rustfp::unit_t, parse_error>;
+
+            static constexpr parse_fn PARSE_FNS[] = {&parse_field<Ser, Is>...};
+            static constexpr missing_fn MISSING_FNS[] = {&parse_missing_field<Ser, Is>...};
+
+            constexpr size_t N = sizeof...(Is);
+            bool seen[N] = {};
+
+            for (const auto &member : obj) {
+                const auto index = field_index<Ser>::hash.find(member.first.data(), member.first.size());
+
+                if (index < N) {
+                    const auto res = PARSE_FNS[index](ser, member.second);
+
+                    if (res.is_err()) {
+                        return ::rustfp::Err(res.get_err_unchecked());
+                    }
+
+                    seen[index] = true;
+                }
+            }
+
+            for (size_t index = 0; index < N; ++index) {
+                if (!seen[index]) {
+                    const auto res = MISSING_FNS[index](ser, obj);
+
+                    if (res.is_err()) {
+                        return ::rustfp::Err(res.get_err_unchecked());
+                    }
+                }
+            }
+
+            return ::rustfp::Ok(std::ref(ser));
+        }
+
+        template <class Ser>
+        auto parse_fields_value(Ser &ser, const dom_val &val) -> ::rustfp::Result<Ser &, parse_error> {
+            return as_obj(val).and_then([&ser](const dom_obj &obj) {
+                return parse_fields_obj(ser, obj, std::make_index_sequence<field_index<Ser>::COUNT>());
+            });
+        }
+
+        template <class Ser, size_t... Is>
+        void serialize_fields_obj(const Ser &ser, dom_obj &obj, std::index_sequence<Is...>) {
+            using expand = int[];
+            obj.reserve(obj.size() + sizeof...(Is));
+
+            static_cast<void>(expand{0, (serialize_nvp(
+                ser.*std::get<Is>(field_index<Ser>::fields).member,
+                get_field_name<Ser, Is>())(obj), 0)...});
+        }
+
+        template <class Ser>
+        auto serialize_fields_value(const Ser &ser, dom_val &val) -> dom_val & {
+            serialize_fields_obj(ser, create_obj(val), std::make_index_sequence<field_index<Ser>::COUNT>());
+            return val;
+        }
+
+        template <class Ser, size_t... Is>
+        auto add_sax_fields(Ser &ser, sax_fields &fields, std::index_sequence<Is...>) -> sax_fields & {
+            using expand = int[];
+
+            static_cast<void>(expand{0, (fields.add(
+                ser.*std::get<Is>(field_index<Ser>::fields).member,
+                get_field_name<Ser, Is>()), 0)...});
+
+            return fields;
+        }
+
+        template <class Ser>
+        auto add_sax_fields(Ser &ser, sax_fields &fields) -> sax_fields & {
+            return add_sax_fields(ser, fields, std::make_index_sequence<field_index<Ser>::COUNT>());
+        }
+    }
+}
@@ -7,12 +7,18 @@
 
 #pragma once
 
+#include "str_ref.h"
+
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <initializer_list>
 #include <iterator>
-#include <unordered_map>
+#include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -69,12 +75,9 @@ namespace serz {
 
         /**
          * Initializes the iterator with reference to the
-         * insert_map value and the ordering value.
+         * insert_map value and the position of an entry that is not erased.
          */
-        insert_map_iter(
-            typename Imap::inner_type &imap,
-            typename Imap::orderings_type &orderings,
-            const size_t index = 0);
+        insert_map_iter(Imap &imap, const size_t index = 0);
 
         /**
          * Defaulted copy constructor.
@@ -146,14 +149,9 @@ namespace serz {
 
     private:
         /**
-         * Reference wrapper to the implementing map value.
+         * Reference wrapper to the insert_map value.
          */
-        std::reference_wrapper<typename Imap::inner_type> imap;
-
-        /**
-         * Reference wrapper to the ordering value.
-         */
-        std::reference_wrapper<typename Imap::orderings_type> orderings;
+        std::reference_wrapper<Imap> imap;
 
         /**
          * Position of the iterator on the map.
@@ -169,6 +167,8 @@ namespace serz {
         template <class Imapx>
         friend class insert_map_iter;
 
+        friend Imap;
+
     public:
         /**
          * Defines the difference_type type. 
@@ -207,12 +207,9 @@ namespace serz {
 
         /**
          * Initializes the const iterator with reference to the
-         * insert_map value and the ordering value.
+         * insert_map value and the position of an entry that is not erased.
          */
-        insert_map_const_iter(
-            const typename Imap::inner_type &imap,
-            const typename Imap::orderings_type &orderings,
-            const size_t index = 0);
+        insert_map_const_iter(const Imap &imap, const size_t index = 0);
 
         /**
          * Implicit converting constructor from non-const iterator.
@@ -277,14 +274,9 @@ namespace serz {
 
     private:
         /**
-         * Const reference wrapper to the implementing map value.
+         * Const reference wrapper to the insert_map value.
          */
-        std::reference_wrapper<const typename Imap::inner_type> imap;
-
-        /**
-         * Const reference wrapper to the ordering value.
-         */
-        std::reference_wrapper<const typename Imap::orderings_type> orderings;
+        std::reference_wrapper<const Imap> imap;
 
         /**
          * Position of the iterator on the map.
@@ -292,82 +284,143 @@ namespace serz {
         size_t index;
     };
 
-    /**
-     * Implements map while preserving insertion order.
-     * Key must be copy constructible. 
-     */
-    template <class Key, class T>
-    class insert_map {
-    public:
+    namespace details {
+        /**
+         * Hashes the keys of insert_map. Generic case.
+         */
+        template <class Key>
+        struct insert_map_hash : std::hash<Key> {};
+
         /**
-         * Alias to the map implementation type.
+         * Hashes the string keys of insert_map by their characters, so that
+         * a str_ref or null terminated characters hash the same as the owned string.
          */
-        using inner_type = std::unordered_map<Key, T>;
+        template <>
+        struct insert_map_hash<std::string> {
+            auto operator()(const str_ref &key) const -> size_t;
+        };
 
         /**
-         * Alias to the ordering value type.
+         * Compares the keys of insert_map with a key that is looked up.
          */
-        using orderings_type = std::vector<Key>;
+        template <class Key, class K>
+        auto insert_map_key_eq(const Key &lhs, const K &rhs) -> bool;
 
+        /**
+         * Compares the string keys of insert_map by their lengths first.
+         */
+        auto insert_map_key_eq(const std::string &lhs, const std::string &rhs) -> bool;
+
+        /**
+         * Compares the string keys of insert_map with a referenced string.
+         */
+        auto insert_map_key_eq(const std::string &lhs, const str_ref &rhs) -> bool;
+
+        /**
+         * Counts the elements in the range, which can be done up front for forward iterators.
+         */
+        template <class ForwardIt>
+        auto insert_map_count_hint(ForwardIt first, ForwardIt last, std::forward_iterator_tag) -> size_t;
+
+        /**
+         * Gives no count, since a single pass input range cannot be counted up front.
+         */
+        template <class InputIt>
+        auto insert_map_count_hint(InputIt first, InputIt last, std::input_iterator_tag) -> size_t;
+    }
+
+    /**
+     * Implements map while preserving insertion order.
+     * Key must be copy constructible. Entries are kept contiguously in
+     * insertion order, so that iterating is a linear scan. Small maps are
+     * searched linearly, while larger maps get an open-addressing index of
+     * 32-bit entry numbers, so that finding takes a single hash probe
+     * sequence. String keys can be found by str_ref or null terminated
+     * characters without building a string. Each key is stored only once.
+     * Erasing only marks the entry as erased, and the erased entries are
+     * dropped together once they make up half of the entries.
+     * Inserting may move the entries, which invalidates references to them.
+     * Erasing may drop the erased entries, which invalidates all iterators
+     * and references.
+     * The key of an entry must not be modified through an iterator.
+     */
+    template <class Key, class T>
+    class insert_map {
+        friend class insert_map_iter<insert_map>;
+        friend class insert_map_const_iter<insert_map>;
+
+    public:
         /**
          * Defines key_type type.
          */
-        using key_type = typename inner_type::key_type;
+        using key_type = Key;
 
         /**
          * Defines mapped_type type.
          */
-        using mapped_type = typename inner_type::mapped_type;
+        using mapped_type = T;
 
         /**
-         * Defines value_type type.
+         * Defines value_type type. The key is not const, so that
+         * the entries can be stored contiguously and moved around.
          */
-        using value_type = typename inner_type::value_type;
+        using value_type = std::pair<Key, T>;
 
         /**
          * Defines size_type type.
          */
-        using size_type = typename inner_type::size_type;
+        using size_type = size_t;
 
         /**
          * Defines difference_type type.
          */
-        using difference_type = typename inner_type::difference_type;
+        using difference_type = ptrdiff_t;
 
         /**
          * Defines hasher type.
          */
-        using hasher = typename inner_type::hasher;
+        using hasher = details::insert_map_hash<Key>;
 
         /**
          * Defines key_equal type.
          */
-        using key_equal = typename inner_type::key_equal;
+        using key_equal = std::equal_to<Key>;
 
         /**
          * Defines allocator_type type.
          */
-        using allocator_type = typename inner_type::allocator_type;
+        using allocator_type = std::allocator<value_type>;
 
         /**
          * Defines reference type.
          */
-        using reference = typename inner_type::reference;
+        using reference = value_type &;
 
         /**
          * Defines const_reference type.
          */
-        using const_reference = typename inner_type::const_reference;
+        using const_reference = const value_type &;
 
         /**
          * Defines pointer type.
          */
-        using pointer = typename inner_type::pointer;
+        using pointer = value_type *;
 
         /**
          * Defines const_pointer type.
          */
-        using const_pointer = typename inner_type::const_pointer;
+        using const_pointer = const value_type *;
+
+        /**
+         * Alias to the type holding the entries in insertion order.
+         */
+        using entries_type = std::vector<value_type>;
+
+        /**
+         * Alias to the open-addressing index, where each slot holds
+         * the position of an entry plus one, or zero if the slot is empty.
+         */
+        using slots_type = std::vector<uint32_t>;
 
         /**
          * Defines iterator type.
@@ -384,6 +437,19 @@ namespace serz {
          */
         insert_map() = default;
 
+        /**
+         * Initializes with the elements in the given range, keeping the first
+         * of any duplicated keys. Reserves for all the elements up front if
+         * the range can be counted.
+         */
+        template <class InputIt>
+        insert_map(InputIt first, InputIt last);
+
+        /**
+         * Initializes with the given elements, keeping the first of any duplicated keys.
+         */
+        insert_map(std::initializer_list<value_type> init);
+
         /**
          * Defaulted copy constructor.
          */
@@ -437,7 +503,7 @@ namespace serz {
         auto cend() const -> const_iterator;
 
         /**
-         * Performs map-find process to find the iterator with position
+         * Probes the index to find the iterator with position
          * of the given key. Returns iterator that points to end if no such key
          * was found. 
          */
@@ -450,18 +516,69 @@ namespace serz {
         auto find(const Key &key) const -> const_iterator;
 
         /**
-         * Perfect forwards all the given arguments
-         * into the emplace of the map implementation type.
+         * Same as above find, except looks up string keys by reference,
+         * without copying the key into a string.
+         */
+        auto find(const str_ref &key) -> iterator;
+
+        /**
+         * Same as above find, except returns const iterator for
+         * non-mutating operations.
+         */
+        auto find(const str_ref &key) const -> const_iterator;
+
+        /**
+         * Same as above find, except looks up string keys by
+         * null terminated characters.
+         */
+        auto find(const char key[]) -> iterator;
+
+        /**
+         * Same as above find, except returns const iterator for
+         * non-mutating operations.
+         */
+        auto find(const char key[]) const -> const_iterator;
+
+        /**
+         * Perfect forwards all the given arguments into the constructor of value_type.
          * Typically meant for directly constructing the key and value.
+         * Does nothing if the key already exists.
          */
         template <class... Args>
         auto emplace(Args &&... args) -> std::pair<iterator, bool>;
 
+        /**
+         * Same as above emplace, except that the key is looked up before anything
+         * is constructed, so that an existing key costs neither a construction
+         * nor the invalidation of any iterator.
+         */
+        template <class K, class M>
+        auto emplace(K &&key, M &&mapped) -> std::pair<iterator, bool>;
+
         /**
          * Erases the element at the given const iterator position.
+         * Takes amortized constant time.
          */
         void erase(const_iterator pos);
 
+        /**
+         * Erases every element for which the predicate returns true, in a single pass.
+         * Returns the number of erased elements.
+         */
+        template <class Pred>
+        auto erase_if(Pred &&pred) -> size_t;
+
+        /**
+         * Reserves room for the given number of elements, so that inserting
+         * up to that many elements neither reallocates nor rehashes.
+         */
+        void reserve(const size_t count);
+
+        /**
+         * Gets the number of elements that can be held without reallocating.
+         */
+        auto capacity() const -> size_t;
+
         /**
          * Checks if the object is empty.
          */
@@ -474,44 +591,163 @@ namespace serz {
 
     private:
         /**
-         * Holds the actual map implementation.
+         * Largest number of entries that are searched linearly without an index.
+         */
+        static constexpr size_t SMALL_MAX = 8;
+
+        /**
+         * Smallest number of slots of an index.
+         */
+        static constexpr size_t MIN_SLOT_COUNT = 16;
+
+        /**
+         * Gets the position of the entry with the given key,
+         * or the number of entries if there is no such key.
+         */
+        template <class K>
+        auto find_index(const K &key) const -> size_t;
+
+        /**
+         * Emplaces the key of the key type, which is looked up as it is.
+         */
+        template <class K, class M>
+        auto emplace_key(std::true_type, K &&key, M &&mapped) -> std::pair<iterator, bool>;
+
+        /**
+         * Emplaces the key of another type, which is converted into the key type first.
+         */
+        template <class K, class M>
+        auto emplace_key(std::false_type, K &&key, M &&mapped) -> std::pair<iterator, bool>;
+
+        /**
+         * Registers the entry just appended to the back.
+         */
+        auto add_back() -> std::pair<iterator, bool>;
+
+        /**
+         * Gets the slot where probing for the given key starts.
+         */
+        template <class K>
+        auto home_slot(const K &key) const -> size_t;
+
+        /**
+         * Records the entry at the given position in the first empty slot of its probe sequence.
+         */
+        void index_entry(const size_t index);
+
+        /**
+         * Rebuilds the index to fit the given number of entries,
+         * or drops it if that is small enough to be searched linearly.
+         */
+        void rebuild_index(const size_t entry_count);
+
+        /**
+         * Checks if the entry at the given position is not erased.
+         */
+        auto is_live(const size_t index) const -> bool;
+
+        /**
+         * Gets the position of the first entry from the given position
+         * that is not erased, or the number of entries if there is none.
+         */
+        auto next_live(size_t index) const -> size_t;
+
+        /**
+         * Marks the entry at the given position as erased, and releases its mapped value.
+         */
+        void mark_erased(const size_t index);
+
+        /**
+         * Drops the erased entries once they make up half of the entries.
+         */
+        void compact_if_sparse();
+
+        /**
+         * Holds the entries in insertion order.
+         */
+        entries_type entries;
+
+        /**
+         * Open-addressing index with linear probing, kept at most half full.
          */
-        inner_type impl;
+        slots_type slots;
 
         /**
-         * Holds the struct that stores insertion ordering. 
+         * Flags the erased entries. Empty if no entry is erased.
          */
-        orderings_type orderings;
+        std::vector<bool> erased;
+
+        /**
+         * Number of erased entries.
+         */
+        size_t erased_count = 0;
     };
 
     // implementation section
 
+    namespace details {
+        inline auto insert_map_hash<std::string>::operator()(const str_ref &key) const -> size_t {
+            // FNV-1a, since std::hash cannot hash characters that are not in a string
+            uint64_t hash = 14695981039346656037ull;
+
+            for (const char c : key) {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+            }
+
+            return static_cast<size_t>(hash ^ (hash >> 32));
+        }
+
+        template <class Key, class K>
+        auto insert_map_key_eq(const Key &lhs, const K &rhs) -> bool {
+            return lhs == rhs;
+        }
+
+        inline auto insert_map_key_eq(const std::string &lhs, const std::string &rhs) -> bool {
+            return lhs.size() == rhs.size() &&
+                std::char_traits<char>::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+        }
+
+        inline auto insert_map_key_eq(const std::string &lhs, const str_ref &rhs) -> bool {
+            return lhs.size() == rhs.size() &&
+                std::char_traits<char>::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+        }
+
+        template <class ForwardIt>
+        auto insert_map_count_hint(ForwardIt first, ForwardIt last, std::forward_iterator_tag) -> size_t {
+            return static_cast<size_t>(std::distance(first, last));
+        }
+
+        template <class InputIt>
+        auto insert_map_count_hint(InputIt, InputIt, std::input_iterator_tag) -> size_t {
+            return 0;
+        }
+    }
+
     template <class Imap>
-    insert_map_iter<Imap>::insert_map_iter(typename Imap::inner_type &imap, typename Imap::orderings_type &orderings, const size_t index) :
+    insert_map_iter<Imap>::insert_map_iter(Imap &imap, const size_t index) :
         imap(imap),
-        orderings(orderings),
         index(index) {
 
     }
 
     template <class Imap>
     auto insert_map_iter<Imap>::operator!=(const insert_map_iter &rhs) const -> bool {
-        return index != rhs.index || &orderings.get() != &rhs.orderings.get() || &imap.get() != &rhs.imap.get();
+        return index != rhs.index || &imap.get() != &rhs.imap.get();
     }
 
     template <class Imap>
     auto insert_map_iter<Imap>::operator!=(const insert_map_const_iter<Imap> &rhs) const -> bool {
-        return index != rhs.index || &orderings.get() != &rhs.orderings.get() || &imap.get() != &rhs.imap.get();
+        return index != rhs.index || &imap.get() != &rhs.imap.get();
     }
 
     template <class Imap>
     auto insert_map_iter<Imap>::operator*() -> reference {
-        return *imap.get().find(orderings.get()[index]);
+        return imap.get().entries[index];
     }
 
     template <class Imap>
     auto insert_map_iter<Imap>::operator*() const -> const_reference {
-        return *imap.get().find(orderings.get()[index]);
+        return imap.get().entries[index];
     }
 
     template <class Imap>
@@ -526,7 +762,7 @@ namespace serz {
 
     template <class Imap>
     auto insert_map_iter<Imap>::operator++() -> insert_map_iter & {
-        ++index;
+        index = imap.get().next_live(index + 1);
         return *this;
     }
 
@@ -538,9 +774,8 @@ namespace serz {
     }
 
     template <class Imap>
-    insert_map_const_iter<Imap>::insert_map_const_iter(const typename Imap::inner_type &imap, const typename Imap::orderings_type &orderings, const size_t index) :
+    insert_map_const_iter<Imap>::insert_map_const_iter(const Imap &imap, const size_t index) :
         imap(imap),
-        orderings(orderings),
         index(index) {
 
     }
@@ -548,24 +783,23 @@ namespace serz {
     template <class Imap>
     insert_map_const_iter<Imap>::insert_map_const_iter(const insert_map_iter<Imap> &rhs) :
         imap(rhs.imap),
-        orderings(rhs.orderings),
         index(rhs.index) {
 
     }
 
     template <class Imap>
     auto insert_map_const_iter<Imap>::operator!=(const insert_map_const_iter &rhs) const -> bool {
-        return index != rhs.index || &orderings.get() != &rhs.orderings.get() || &imap.get() != &rhs.imap.get();
+        return index != rhs.index || &imap.get() != &rhs.imap.get();
     }
 
     template<class Imap>
     auto insert_map_const_iter<Imap>::operator!=(const insert_map_iter<Imap> &rhs) const -> bool {
-        return index != rhs.index || &orderings.get() != &rhs.orderings.get() || &imap.get() != &rhs.imap.get();
+        return index != rhs.index || &imap.get() != &rhs.imap.get();
     }
 
     template <class Imap>
     auto insert_map_const_iter<Imap>::operator*() const -> const_reference {
-        return *imap.get().find(orderings.get()[index]);
+        return imap.get().entries[index];
     }
 
     template <class Imap>
@@ -575,7 +809,7 @@ namespace serz {
 
     template <class Imap>
     auto insert_map_const_iter<Imap>::operator++() -> insert_map_const_iter & {
-        ++index;
+        index = imap.get().next_live(index + 1);
         return *this;
     }
 
@@ -586,14 +820,31 @@ namespace serz {
         return it;
     }
 
+    template <class Key, class T>
+    template <class InputIt>
+    insert_map<Key, T>::insert_map(InputIt first, InputIt last) {
+        reserve(details::insert_map_count_hint(
+            first, last, typename std::iterator_traits<InputIt>::iterator_category()));
+
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    template <class Key, class T>
+    insert_map<Key, T>::insert_map(std::initializer_list<value_type> init) :
+        insert_map(init.begin(), init.end()) {
+
+    }
+
     template <class Key, class T>
     auto insert_map<Key, T>::begin() -> iterator {
-        return iterator(impl, orderings, 0);
+        return iterator(*this, next_live(0));
     }
 
     template <class Key, class T>
     auto insert_map<Key, T>::begin() const -> const_iterator {
-        return const_iterator(impl, orderings, 0);
+        return const_iterator(*this, next_live(0));
     }
 
     template <class Key, class T>
@@ -603,12 +854,12 @@ namespace serz {
 
     template <class Key, class T>
     auto insert_map<Key, T>::end() -> iterator {
-        return iterator(impl, orderings, orderings.size());
+        return iterator(*this, entries.size());
     }
 
     template <class Key, class T>
     auto insert_map<Key, T>::end() const -> const_iterator {
-        return const_iterator(impl, orderings, orderings.size());
+        return const_iterator(*this, entries.size());
     }
 
     template <class Key, class T>
@@ -618,70 +869,272 @@ namespace serz {
 
     template <class Key, class T>
     auto insert_map<Key, T>::find(const Key &key) -> iterator {
-        const auto end_it = end();
+        return iterator(*this, find_index(key));
+    }
 
-        for (auto it = begin(); it != end_it; ++it) {
-            if (it->first == key) {
-                return it;
-            }
-        }
+    template <class Key, class T>
+    auto insert_map<Key, T>::find(const Key &key) const -> const_iterator {
+        return const_iterator(*this, find_index(key));
+    }
 
-        return end();
+    template <class Key, class T>
+    auto insert_map<Key, T>::find(const str_ref &key) -> iterator {
+        return iterator(*this, find_index(key));
     }
 
     template <class Key, class T>
-    auto insert_map<Key, T>::find(const Key &key) const -> const_iterator {
-        const auto end_it = end();
+    auto insert_map<Key, T>::find(const str_ref &key) const -> const_iterator {
+        return const_iterator(*this, find_index(key));
+    }
 
-        for (auto it = begin(); it != end_it; ++it) {
-            if (it->first == key) {
-                return it;
-            }
-        }
+    template <class Key, class T>
+    auto insert_map<Key, T>::find(const char key[]) -> iterator {
+        // measures the characters once rather than on every comparison
+        return find(str_ref(key));
+    }
 
-        return end();
+    template <class Key, class T>
+    auto insert_map<Key, T>::find(const char key[]) const -> const_iterator {
+        return find(str_ref(key));
     }
 
     template <class Key, class T>
     void insert_map<Key, T>::erase(const_iterator pos) {
-        const auto &name = pos->first;
-        const auto impl_it = impl.find(name);
-
-        if (impl_it != impl.cend()) {
-            const auto orderings_it = std::find_if(orderings.cbegin(), orderings.cend(),
-                [&name](const Key &orderingName) {
-                    return orderingName == name;
-                });
-
-            if (orderings_it != orderings.cend()) {
-                orderings.erase(orderings_it);
-                impl.erase(impl_it);
+        if (pos.index < entries.size() && is_live(pos.index)) {
+            mark_erased(pos.index);
+            compact_if_sparse();
+        }
+    }
+
+    template <class Key, class T>
+    template <class Pred>
+    auto insert_map<Key, T>::erase_if(Pred &&pred) -> size_t {
+        size_t count = 0;
+
+        for (size_t index = 0; index < entries.size(); ++index) {
+            if (is_live(index) && pred(static_cast<const value_type &>(entries[index]))) {
+                mark_erased(index);
+                ++count;
             }
         }
+
+        compact_if_sparse();
+        return count;
     }
 
     template <class Key, class T>
     template <class... Args>
     auto insert_map<Key, T>::emplace(Args &&... args) -> std::pair<iterator, bool> {
-        const auto res = impl.emplace(std::forward<Args>(args)...);
-
-        if (res.second) {
-            // insert new entry into ordering
-            orderings.push_back(res.first->first);
-            return std::make_pair(iterator(impl, orderings, orderings.size() - 1), true);
-        } else {
-            // use find on the key to get the iterator
-            return std::make_pair(find(res.first->first), false);
+        // constructs in place first, since the key may only be known from the arguments
+        entries.emplace_back(std::forward<Args>(args)...);
+
+        // the flag must cover the new entry before it can be searched
+        if (!erased.empty()) {
+            erased.push_back(false);
+        }
+
+        const auto index = find_index(entries.back().first);
+
+        if (index < entries.size() - 1) {
+            entries.pop_back();
+
+            if (!erased.empty()) {
+                erased.pop_back();
+            }
+
+            return std::make_pair(iterator(*this, index), false);
+        }
+
+        return add_back();
+    }
+
+    template <class Key, class T>
+    template <class K, class M>
+    auto insert_map<Key, T>::emplace(K &&key, M &&mapped) -> std::pair<iterator, bool> {
+        return emplace_key(
+            std::is_same<std::decay_t<K>, Key>(),
+            std::forward<K>(key),
+            std::forward<M>(mapped));
+    }
+
+    template <class Key, class T>
+    template <class K, class M>
+    auto insert_map<Key, T>::emplace_key(std::true_type, K &&key, M &&mapped) -> std::pair<iterator, bool> {
+        const auto index = find_index(key);
+
+        if (index < entries.size()) {
+            return std::make_pair(iterator(*this, index), false);
+        }
+
+        entries.emplace_back(
+            std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<M>(mapped)));
+
+        if (!erased.empty()) {
+            erased.push_back(false);
+        }
+
+        return add_back();
+    }
+
+    template <class Key, class T>
+    template <class K, class M>
+    auto insert_map<Key, T>::emplace_key(std::false_type, K &&key, M &&mapped) -> std::pair<iterator, bool> {
+        return emplace_key(std::true_type(), Key(std::forward<K>(key)), std::forward<M>(mapped));
+    }
+
+    template <class Key, class T>
+    auto insert_map<Key, T>::add_back() -> std::pair<iterator, bool> {
+        // a reserved index is at least twice the largest small map
+        if (entries.size() * 2 <= slots.size()) {
+            index_entry(entries.size() - 1);
+        } else if (entries.size() > SMALL_MAX) {
+            rebuild_index(entries.size());
         }
+
+        return std::make_pair(iterator(*this, entries.size() - 1), true);
+    }
+
+    template <class Key, class T>
+    void insert_map<Key, T>::reserve(const size_t count) {
+        entries.reserve(count);
+
+        if (count > SMALL_MAX && count * 2 > slots.size()) {
+            rebuild_index(count);
+        }
+    }
+
+    template <class Key, class T>
+    auto insert_map<Key, T>::capacity() const -> size_t {
+        return entries.capacity();
     }
 
     template <class Key, class T>
     auto insert_map<Key, T>::empty() const -> bool {
-        return impl.empty();
+        return size() == 0;
     }
 
     template <class Key, class T>
     auto insert_map<Key, T>::size() const -> size_t {
-        return impl.size();
+        return entries.size() - erased_count;
+    }
+
+    template <class Key, class T>
+    template <class K>
+    auto insert_map<Key, T>::find_index(const K &key) const -> size_t {
+        if (slots.empty()) {
+            for (size_t index = 0; index < entries.size(); ++index) {
+                if (is_live(index) && details::insert_map_key_eq(entries[index].first, key)) {
+                    return index;
+                }
+            }
+
+            return entries.size();
+        }
+
+        const auto mask = slots.size() - 1;
+
+        for (auto slot = home_slot(key); slots[slot] != 0; slot = (slot + 1) & mask) {
+            const auto index = static_cast<size_t>(slots[slot] - 1);
+
+            // an erased entry may share the key with a later entry
+            if (is_live(index) && details::insert_map_key_eq(entries[index].first, key)) {
+                return index;
+            }
+        }
+
+        return entries.size();
+    }
+
+    template <class Key, class T>
+    template <class K>
+    auto insert_map<Key, T>::home_slot(const K &key) const -> size_t {
+        return hasher()(key) & (slots.size() - 1);
+    }
+
+    template <class Key, class T>
+    void insert_map<Key, T>::index_entry(const size_t index) {
+        const auto mask = slots.size() - 1;
+        auto slot = home_slot(entries[index].first);
+
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+
+        slots[slot] = static_cast<uint32_t>(index + 1);
+    }
+
+    template <class Key, class T>
+    void insert_map<Key, T>::rebuild_index(const size_t entry_count) {
+        if (entry_count <= SMALL_MAX) {
+            slots = slots_type();
+            return;
+        }
+
+        auto slot_count = MIN_SLOT_COUNT;
+
+        while (slot_count < entry_count * 2) {
+            slot_count *= 2;
+        }
+
+        slots.assign(slot_count, 0);
+
+        for (size_t index = 0; index < entries.size(); ++index) {
+            if (is_live(index)) {
+                index_entry(index);
+            }
+        }
+    }
+
+    template <class Key, class T>
+    auto insert_map<Key, T>::is_live(const size_t index) const -> bool {
+        return erased.empty() || !erased[index];
+    }
+
+    template <class Key, class T>
+    auto insert_map<Key, T>::next_live(size_t index) const -> size_t {
+        while (index < entries.size() && !is_live(index)) {
+            ++index;
+        }
+
+        return index;
+    }
+
+    template <class Key, class T>
+    void insert_map<Key, T>::mark_erased(const size_t index) {
+        if (erased.empty()) {
+            erased.assign(entries.size(), false);
+        }
+
+        erased[index] = true;
+        ++erased_count;
+
+        // the key is kept until compaction, but the value can go right away
+        entries[index].second = T();
+    }
+
+    template <class Key, class T>
+    void insert_map<Key, T>::compact_if_sparse() {
+        if (erased_count * 2 < entries.size() || erased_count == 0) {
+            return;
+        }
+
+        size_t live_count = 0;
+
+        for (size_t index = 0; index < entries.size(); ++index) {
+            if (!erased[index]) {
+                if (live_count != index) {
+                    entries[live_count] = std::move(entries[index]);
+                }
+
+                ++live_count;
+            }
+        }
+
+        entries.erase(entries.begin() + static_cast<difference_type>(live_count), entries.end());
+        erased.clear();
+        erased_count = 0;
+        rebuild_index(entries.size());
     }
 }
@@ -0,0 +1,269 @@
+/**
+ * Contains read-only view of a whole file's content, which is memory-mapped
+ * where the platform allows it, and read into a single buffer otherwise.
+ * @author Chen Weiguang
+ * @version 0.1.0
+ */
+
+#pragma once
+
+#include "rustfp/result.h"
+
+#ifndef FMT_HEADER_ONLY
+#define FMT_HEADER_ONLY
+#endif
+#include "fmt/format.h"
+
+#if !defined(SERZ_DISABLE_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#define SERZ_HAS_MMAP
+#endif
+
+#ifdef SERZ_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace serz {
+    // declaration section
+
+    /**
+     * Read-only content of a whole file. Regular files are memory-mapped
+     * with a sequential access hint, so that parsing reads straight from the
+     * page cache. Falls back to reading into a single buffer when mapping is
+     * not available, e.g. for pipes or when SERZ_DISABLE_MMAP is defined.
+     */
+    class mapped_file {
+    public:
+        /**
+         * Opens the file at the given path and exposes its whole content.
+         */
+        static auto open(const std::string &file_path) -> ::rustfp::Result<mapped_file, std::string>;
+
+        /**
+         * Takes over the content of the other instance.
+         */
+        mapped_file(mapped_file &&rhs) noexcept;
+
+        /**
+         * Releases the current content and takes over the content of the other instance.
+         */
+        auto operator=(mapped_file &&rhs) noexcept -> mapped_file &;
+
+        /**
+         * Deleted copy constructor.
+         */
+        mapped_file(const mapped_file &) = delete;
+
+        /**
+         * Deleted copy assignment.
+         */
+        auto operator=(const mapped_file &) -> mapped_file & = delete;
+
+        /**
+         * Unmaps or frees the content.
+         */
+        ~mapped_file();
+
+        /**
+         * Gets the pointer to the first character of the content.
+         * The content is not null terminated.
+         */
+        auto data() const -> const char *;
+
+        /**
+         * Gets the number of characters of the content.
+         */
+        auto size() const -> size_t;
+
+        /**
+         * Checks if the content is memory-mapped, instead of being read into a buffer.
+         */
+        auto is_mapped() const -> bool;
+
+    private:
+        /**
+         * Initializes an instance with empty content.
+         */
+        mapped_file();
+
+        /**
+         * Reads the whole content of the file at the given path into the buffer.
+         */
+        static auto read_into_buf(mapped_file &file, const std::string &file_path) -> bool;
+
+        /**
+         * Releases the mapping if it is present.
+         */
+        void release();
+
+        /**
+         * Points to the first character of either the mapping or the buffer.
+         */
+        const char *ptr;
+
+        /**
+         * Number of characters of the content.
+         */
+        size_t len;
+
+        /**
+         * Indicates if ptr refers to a mapping that needs to be released.
+         */
+        bool mapped;
+
+        /**
+         * Holds the content when it is not memory-mapped.
+         */
+        std::vector<char> buf;
+    };
+
+    // implementation section
+
+    inline mapped_file::mapped_file() :
+        ptr(nullptr),
+        len(0),
+        mapped(false) {
+
+    }
+
+    inline mapped_file::mapped_file(mapped_file &&rhs) noexcept :
+        ptr(rhs.ptr),
+        len(rhs.len),
+        mapped(rhs.mapped),
+        buf(std::move(rhs.buf)) {
+
+        if (!mapped) {
+            ptr = buf.data();
+        }
+
+        rhs.ptr = nullptr;
+        rhs.len = 0;
+        rhs.mapped = false;
+    }
+
+    inline auto mapped_file::operator=(mapped_file &&rhs) noexcept -> mapped_file & {
+        if (this != &rhs) {
+            release();
+
+            ptr = rhs.ptr;
+            len = rhs.len;
+            mapped = rhs.mapped;
+            buf = std::move(rhs.buf);
+
+            if (!mapped) {
+                ptr = buf.data();
+            }
+
+            rhs.ptr = nullptr;
+            rhs.len = 0;
+            rhs.mapped = false;
+        }
+
+        return *this;
+    }
+
+    inline mapped_file::~mapped_file() {
+        release();
+    }
+
+    inline auto mapped_file::open(const std::string &file_path) -> ::rustfp::Result<mapped_file, std::string> {
+        mapped_file file;
+
+#ifdef SERZ_HAS_MMAP
+        const int fd = ::open(file_path.c_str(), O_RDONLY);
+
+        if (fd < 0) {
+            return ::rustfp::Err(fmt::format("Cannot open file at '{}'", file_path));
+        }
+
+        struct stat file_stat;
+
+        // empty and special files have no meaningful size to map
+        if (::fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) && file_stat.st_size > 0) {
+            const auto file_len = static_cast<size_t>(file_stat.st_size);
+            void *addr = ::mmap(nullptr, file_len, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (addr != MAP_FAILED) {
+                ::madvise(addr, file_len, MADV_SEQUENTIAL);
+
+                file.ptr = static_cast<const char *>(addr);
+                file.len = file_len;
+                file.mapped = true;
+            }
+        }
+
+        ::close(fd);
+
+        if (file.mapped) {
+            return ::rustfp::Ok(std::move(file));
+        }
+#endif
+
+        if (!read_into_buf(file, file_path)) {
+            return ::rustfp::Err(fmt::format("Cannot open file at '{}'", file_path));
+        }
+
+        return ::rustfp::Ok(std::move(file));
+    }
+
+    inline auto mapped_file::data() const -> const char * {
+        return ptr;
+    }
+
+    inline auto mapped_file::size() const -> size_t {
+        return len;
+    }
+
+    inline auto mapped_file::is_mapped() const -> bool {
+        return mapped;
+    }
+
+    inline auto mapped_file::read_into_buf(mapped_file &file, const std::string &file_path) -> bool {
+        std::ifstream file_stream(file_path, std::ios::binary);
+
+        if (!file_stream) {
+            return false;
+        }
+
+        // reads in one go if the stream is seekable, otherwise drains it
+        const auto end_pos = file_stream.seekg(0, std::ios::end).tellg();
+
+        if (end_pos > 0 && file_stream.seekg(0, std::ios::beg)) {
+            file.buf.resize(static_cast<size_t>(end_pos));
+            file_stream.read(file.buf.data(), end_pos);
+            file.buf.resize(static_cast<size_t>(file_stream.gcount()));
+        } else {
+            file_stream.clear();
+            file_stream.seekg(0, std::ios::beg);
+
+            file.buf.assign(
+                std::istreambuf_iterator<char>(file_stream),
+                std::istreambuf_iterator<char>());
+        }
+
+        file.ptr = file.buf.data();
+        file.len = file.buf.size();
+        return true;
+    }
+
+    inline void mapped_file::release() {
+#ifdef SERZ_HAS_MMAP
+        if (mapped) {
+            ::munmap(const_cast<char *>(ptr), len);
+        }
+#endif
+
+        ptr = nullptr;
+        len = 0;
+        mapped = false;
+    }
+}
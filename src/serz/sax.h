@@ -0,0 +1,1453 @@
+/**
+ * Provides event-driven parsing that writes directly into serializable values,
+ * bypassing the intermediate DOM representation where possible.
+ * @author Chen Weiguang
+ * @version 0.1.0
+ */
+
+#pragma once
+
+#include "serialization.h"
+#include "str_ref.h"
+#include "val.h"
+
+#include "rustfp/option.h"
+
+#ifndef FMT_HEADER_ONLY
+#define FMT_HEADER_ONLY
+#endif
+#include "fmt/format.h"
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace serz {
+    // declaration section
+
+    // forward declaration
+    class sax_ctx;
+
+    // forward declaration
+    class sax_fields;
+
+    /**
+     * Describes the outcome of feeding a single event into a sink.
+     */
+    enum class sax_step {
+        /** Event is consumed and the sink expects more events. */
+        more,
+        /** Event is consumed and the sink has completed its value. */
+        done,
+        /** Sink has pushed a child sink which must receive the same event. */
+        forward,
+        /** Sink rejects the event, with the error message held in the context. */
+        fail,
+    };
+
+    /**
+     * Receives the parsing events of a single value and writes the value
+     * directly into its target. All value events are routed into on_value
+     * unless overridden, which rejects the event by default.
+     */
+    class sax_sink {
+    public:
+        /**
+         * Defaulted virtual destructor.
+         */
+        virtual ~sax_sink() = default;
+
+        /**
+         * Receives a null value.
+         */
+        virtual auto on_null(sax_ctx &ctx) -> sax_step;
+
+        /**
+         * Receives a boolean value.
+         */
+        virtual auto on_bln(sax_ctx &ctx, const dom_bln bln) -> sax_step;
+
+        /**
+         * Receives an integer value.
+         */
+        virtual auto on_int(sax_ctx &ctx, const dom_int itg) -> sax_step;
+
+        /**
+         * Receives a floating point value.
+         */
+        virtual auto on_flt(sax_ctx &ctx, const dom_flt flt) -> sax_step;
+
+        /**
+         * Receives a string value, which is null terminated at len.
+         */
+        virtual auto on_str(sax_ctx &ctx, const char str[], const size_t len) -> sax_step;
+
+        /**
+         * Receives the start of an object.
+         */
+        virtual auto on_start_obj(sax_ctx &ctx) -> sax_step;
+
+        /**
+         * Receives the key of the next object member.
+         */
+        virtual auto on_key(sax_ctx &ctx, const char key[], const size_t len) -> sax_step;
+
+        /**
+         * Receives the end of an object.
+         */
+        virtual auto on_end_obj(sax_ctx &ctx) -> sax_step;
+
+        /**
+         * Receives the start of an array.
+         */
+        virtual auto on_start_arr(sax_ctx &ctx) -> sax_step;
+
+        /**
+         * Receives the end of an array.
+         */
+        virtual auto on_end_arr(sax_ctx &ctx) -> sax_step;
+
+        /**
+         * Notifies that the child sink pushed by this sink has completed.
+         */
+        virtual auto on_child_done(sax_ctx &ctx) -> sax_step;
+
+    protected:
+        /**
+         * Receives the start of any value that is not overridden.
+         */
+        virtual auto on_value(sax_ctx &ctx) -> sax_step;
+
+        /**
+         * Rejects the current event.
+         */
+        virtual auto mismatch(sax_ctx &ctx) -> sax_step;
+    };
+
+    /**
+     * Holds the stack of sinks and dispatches each event to the top-most sink.
+     */
+    class sax_ctx {
+    public:
+        /**
+         * Initializes the context. In-situ parsing guarantees that every
+         * string value is decoded in place within the buffer being parsed,
+         * which allows string values to be borrowed.
+         */
+        explicit sax_ctx(const bool is_insitu = false);
+
+        /**
+         * Checks if every string value refers into the buffer being parsed.
+         */
+        auto is_insitu() const -> bool;
+
+        /**
+         * Pushes a new sink to receive the subsequent events.
+         */
+        void push(std::unique_ptr<sax_sink> &&sink);
+
+        /**
+         * Drops every pushed sink and the stored error message, keeping the
+         * allocated capacity so that the context can be reused for the next value.
+         */
+        void reset();
+
+        /**
+         * Stores the error message and returns the failing step.
+         */
+        auto fail(std::string &&err_msg) -> sax_step;
+
+        /**
+         * Gets the stored error message.
+         */
+        auto get_error() const -> const std::string &;
+
+        /**
+         * Checks if every pushed sink has completed.
+         */
+        auto is_done() const -> bool;
+
+        /**
+         * Dispatches a null value.
+         */
+        auto null() -> bool;
+
+        /**
+         * Dispatches a boolean value.
+         */
+        auto bln(const dom_bln bln) -> bool;
+
+        /**
+         * Dispatches an integer value.
+         */
+        auto itg(const dom_int itg) -> bool;
+
+        /**
+         * Dispatches a floating point value.
+         */
+        auto flt(const dom_flt flt) -> bool;
+
+        /**
+         * Dispatches a string value, which must be null terminated at len.
+         */
+        auto str(const char str[], const size_t len) -> bool;
+
+        /**
+         * Dispatches the start of an object.
+         */
+        auto start_obj() -> bool;
+
+        /**
+         * Dispatches the key of the next object member.
+         */
+        auto key(const char key[], const size_t len) -> bool;
+
+        /**
+         * Dispatches the end of an object.
+         */
+        auto end_obj() -> bool;
+
+        /**
+         * Dispatches the start of an array.
+         */
+        auto start_arr() -> bool;
+
+        /**
+         * Dispatches the end of an array.
+         */
+        auto end_arr() -> bool;
+
+    private:
+        template <class... Params, class... Args>
+        auto dispatch(sax_step (sax_sink::*event)(sax_ctx &, Params...), Args &&... args) -> bool;
+
+        auto complete() -> bool;
+
+        /**
+         * Holds the sinks, with the top-most sink at the back.
+         */
+        std::vector<std::unique_ptr<sax_sink>> sinks;
+
+        /**
+         * Holds the error message of the failing event.
+         */
+        std::string err_msg;
+
+        /**
+         * Indicates if the string values refer into the buffer being parsed.
+         */
+        bool insitu;
+    };
+
+    namespace details {
+        struct sax_field {
+            std::string name;
+            void *ser;
+            void (*push)(sax_ctx &ctx, void *ser);
+            auto (*missing)(void *ser) -> bool;
+            bool seen;
+        };
+
+        template <class Ser>
+        struct sax_missing {
+            static auto apply(Ser &ser) -> bool;
+        };
+
+#ifndef SERZ_DISALLOW_MISSING_ARRAY_OBJECT
+
+        template <class Ser>
+        struct sax_missing<std::vector<Ser>> {
+            static auto apply(std::vector<Ser> &ser) -> bool;
+        };
+
+        template <class Ser>
+        struct sax_missing<std::unordered_map<std::string, Ser>> {
+            static auto apply(std::unordered_map<std::string, Ser> &ser) -> bool;
+        };
+
+#endif
+
+        template <class Ser>
+        struct sax_missing<::rustfp::Option<Ser>> {
+            static auto apply(::rustfp::Option<Ser> &ser) -> bool;
+        };
+
+        template <class Ser>
+        auto make_sax_sink(Ser &ser) -> std::unique_ptr<sax_sink>;
+
+        template <class Ser>
+        void push_sax_field(sax_ctx &ctx, void *ser);
+
+        template <class Ser>
+        auto missing_sax_field(void *ser) -> bool;
+
+        template <class Ser, class = void>
+        struct has_parse_fields : std::false_type {};
+
+        template <class Ser>
+        struct has_parse_fields<Ser, decltype(static_cast<void>(
+            parse_fields(std::declval<Ser &>(), std::declval<sax_fields &>())))> :
+            std::true_type {};
+
+        class sax_dom_builder {
+        public:
+            explicit sax_dom_builder(dom_val &root);
+
+            auto put(dom_val &&val) -> bool;
+
+            void open(dom_val &&val);
+
+            void key(const char key[], const size_t len);
+
+            auto close() -> bool;
+
+        private:
+            // returns nullptr if the value is dropped for a duplicated key
+            auto place(dom_val &&val) -> dom_val *;
+
+            std::reference_wrapper<dom_val> root;
+            std::vector<dom_val *> parents;
+            std::string pending_key;
+
+            // depth within the object or array of a dropped duplicated key
+            size_t skip_depth = 0;
+        };
+
+        class sax_skip_sink : public sax_sink {
+        public:
+            auto on_null(sax_ctx &ctx) -> sax_step override;
+            auto on_bln(sax_ctx &ctx, const dom_bln bln) -> sax_step override;
+            auto on_int(sax_ctx &ctx, const dom_int itg) -> sax_step override;
+            auto on_flt(sax_ctx &ctx, const dom_flt flt) -> sax_step override;
+            auto on_str(sax_ctx &ctx, const char str[], const size_t len) -> sax_step override;
+            auto on_start_obj(sax_ctx &ctx) -> sax_step override;
+            auto on_key(sax_ctx &ctx, const char key[], const size_t len) -> sax_step override;
+            auto on_end_obj(sax_ctx &ctx) -> sax_step override;
+            auto on_start_arr(sax_ctx &ctx) -> sax_step override;
+            auto on_end_arr(sax_ctx &ctx) -> sax_step override;
+
+        private:
+            auto scalar() const -> sax_step;
+            auto close() -> sax_step;
+
+            size_t depth = 0;
+        };
+
+        // builds the value as dom_val and passes it to parse_value
+        template <class Ser, class = void>
+        class sax_value_sink : public sax_sink {
+        public:
+            explicit sax_value_sink(Ser &ser);
+
+            auto on_null(sax_ctx &ctx) -> sax_step override;
+            auto on_bln(sax_ctx &ctx, const dom_bln bln) -> sax_step override;
+            auto on_int(sax_ctx &ctx, const dom_int itg) -> sax_step override;
+            auto on_flt(sax_ctx &ctx, const dom_flt flt) -> sax_step override;
+            auto on_str(sax_ctx &ctx, const char str[], const size_t len) -> sax_step override;
+            auto on_start_obj(sax_ctx &ctx) -> sax_step override;
+            auto on_key(sax_ctx &ctx, const char key[], const size_t len) -> sax_step override;
+            auto on_end_obj(sax_ctx &ctx) -> sax_step override;
+            auto on_start_arr(sax_ctx &ctx) -> sax_step override;
+            auto on_end_arr(sax_ctx &ctx) -> sax_step override;
+
+        private:
+            auto finish(sax_ctx &ctx, const bool is_complete) -> sax_step;
+
+            std::reference_wrapper<Ser> ser;
+            dom_val val;
+            sax_dom_builder builder;
+        };
+
+        template <>
+        class sax_value_sink<dom_val> : public sax_sink {
+        public:
+            explicit sax_value_sink(dom_val &ser);
+
+            auto on_null(sax_ctx &ctx) -> sax_step override;
+            auto on_bln(sax_ctx &ctx, const dom_bln bln) -> sax_step override;
+            auto on_int(sax_ctx &ctx, const dom_int itg) -> sax_step override;
+            auto on_flt(sax_ctx &ctx, const dom_flt flt) -> sax_step override;
+            auto on_str(sax_ctx &ctx, const char str[], const size_t len) -> sax_step override;
+            auto on_start_obj(sax_ctx &ctx) -> sax_step override;
+            auto on_key(sax_ctx &ctx, const char key[], const size_t len) -> sax_step override;
+            auto on_end_obj(sax_ctx &ctx) -> sax_step override;
+            auto on_start_arr(sax_ctx &ctx) -> sax_step override;
+            auto on_end_arr(sax_ctx &ctx) -> sax_step override;
+
+        private:
+            static auto finish(const bool is_complete) -> sax_step;
+
+            sax_dom_builder builder;
+        };
+
+        template <>
+        class sax_value_sink<std::string> : public sax_sink {
+        public:
+            explicit sax_value_sink(std::string &ser);
+
+            auto on_null(sax_ctx &ctx) -> sax_step override;
+            auto on_str(sax_ctx &ctx, const char str[], const size_t len) -> sax_step override;
+
+        protected:
+            auto mismatch(sax_ctx &ctx) -> sax_step override;
+
+        private:
+            std::reference_wrapper<std::string> ser;
+        };
+
+        template <>
+        class sax_value_sink<str_ref> : public sax_sink {
+        public:
+            explicit sax_value_sink(str_ref &ser);
+
+            auto on_null(sax_ctx &ctx) -> sax_step override;
+            auto on_str(sax_ctx &ctx, const char str[], const size_t len) -> sax_step override;
+
+        protected:
+            auto mismatch(sax_ctx &ctx) -> sax_step override;
+
+        private:
+            std::reference_wrapper<str_ref> ser;
+        };
+
+        template <class Ser>
+        class sax_value_sink<std::vector<Ser>> : public sax_sink {
+        public:
+            explicit sax_value_sink(std::vector<Ser> &sers);
+
+            auto on_null(sax_ctx &ctx) -> sax_step override;
+            auto on_start_arr(sax_ctx &ctx) -> sax_step override;
+            auto on_end_arr(sax_ctx &ctx) -> sax_step override;
+            auto on_child_done(sax_ctx &ctx) -> sax_step override;
+
+        protected:
+            auto on_value(sax_ctx &ctx) -> sax_step override;
+
+        private:
+            std::reference_wrapper<std::vector<Ser>> sers;
+            bool is_reuse;
+            size_t count = 0;
+            bool is_opened = false;
+            bool is_single = false;
+        };
+
+        template <class Ser>
+        class sax_value_sink<std::unordered_map<std::string, Ser>> : public sax_sink {
+        public:
+            explicit sax_value_sink(std::unordered_map<std::string, Ser> &sers);
+
+            auto on_null(sax_ctx &ctx) -> sax_step override;
+            auto on_start_obj(sax_ctx &ctx) -> sax_step override;
+            auto on_key(sax_ctx &ctx, const char key[], const size_t len) -> sax_step override;
+            auto on_end_obj(sax_ctx &ctx) -> sax_step override;
+
+        protected:
+            auto mismatch(sax_ctx &ctx) -> sax_step override;
+
+        private:
+            std::reference_wrapper<std::unordered_map<std::string, Ser>> sers;
+            bool is_reuse;
+            std::string key_buf;
+            std::unordered_set<const std::string *> seen_keys;
+        };
+
+        template <class Ser>
+        class sax_value_sink<::rustfp::Option<Ser>> : public sax_sink {
+        public:
+            explicit sax_value_sink(::rustfp::Option<Ser> &ser);
+
+            auto on_child_done(sax_ctx &ctx) -> sax_step override;
+
+        protected:
+            auto on_value(sax_ctx &ctx) -> sax_step override;
+
+        private:
+            std::reference_wrapper<::rustfp::Option<Ser>> ser;
+            Ser inner;
+            bool is_in_place = false;
+        };
+    }
+
+    namespace details {
+        // walks down the object members along the key path, and skips all other members
+        class sax_path_sink : public sax_sink {
+        public:
+            sax_path_sink(
+                const std::vector<std::string> &key_path,
+                const size_t index,
+                std::function<std::unique_ptr<sax_sink>()> make_target);
+
+            auto on_start_obj(sax_ctx &ctx) -> sax_step override;
+            auto on_key(sax_ctx &ctx, const char key[], const size_t len) -> sax_step override;
+            auto on_end_obj(sax_ctx &ctx) -> sax_step override;
+
+        protected:
+            auto mismatch(sax_ctx &ctx) -> sax_step override;
+
+        private:
+            std::reference_wrapper<const std::vector<std::string>> key_path;
+            size_t index;
+            std::function<std::unique_ptr<sax_sink>()> make_target;
+            bool is_opened = false;
+            bool is_found = false;
+        };
+
+        // parses every array element into the same value and passes it on, one at a time
+        template <class Ser, class Fn>
+        class sax_each_sink : public sax_sink {
+        public:
+            sax_each_sink(Fn &fn, size_t &count);
+
+            auto on_null(sax_ctx &ctx) -> sax_step override;
+            auto on_start_arr(sax_ctx &ctx) -> sax_step override;
+            auto on_end_arr(sax_ctx &ctx) -> sax_step override;
+            auto on_child_done(sax_ctx &ctx) -> sax_step override;
+
+        protected:
+            auto on_value(sax_ctx &ctx) -> sax_step override;
+            auto mismatch(sax_ctx &ctx) -> sax_step override;
+
+        private:
+            std::reference_wrapper<Fn> fn;
+            std::reference_wrapper<size_t> count;
+            Ser elem;
+            bool is_opened = false;
+        };
+
+        template <class Ser, class Fn>
+        auto make_sax_each_sink(Fn &fn, size_t &count, const std::vector<std::string> &key_path) -> std::unique_ptr<sax_sink>;
+    }
+
+    /**
+     * Holds the table of fields of a serializable value that is parsed
+     * directly from events, built by chaining parse_nvp actions.
+     */
+    class sax_fields {
+        template <class Ser, class>
+        friend class details::sax_value_sink;
+
+    public:
+        /**
+         * Adds a field to be parsed from the member with the given name.
+         */
+        template <class Ser>
+        auto add(Ser &ser, const str_ref &name) -> sax_fields &;
+
+    private:
+        auto find(const char key[], const size_t len) -> details::sax_field *;
+
+        auto complete(sax_ctx &ctx) -> sax_step;
+
+        /**
+         * Holds the fields in the order of declaration.
+         */
+        std::vector<details::sax_field> fields;
+
+        /**
+         * Position to start looking from, which is right after the
+         * previous match since members usually arrive in declaration order.
+         */
+        size_t hint = 0;
+    };
+
+    namespace details {
+        template <class Ser>
+        class sax_value_sink<Ser, std::enable_if_t<has_parse_fields<Ser>::value>> : public sax_sink {
+        public:
+            explicit sax_value_sink(Ser &ser);
+
+            auto on_start_obj(sax_ctx &ctx) -> sax_step override;
+            auto on_key(sax_ctx &ctx, const char key[], const size_t len) -> sax_step override;
+            auto on_end_obj(sax_ctx &ctx) -> sax_step override;
+
+        protected:
+            auto mismatch(sax_ctx &ctx) -> sax_step override;
+
+        private:
+            std::reference_wrapper<Ser> ser;
+            sax_fields fields;
+        };
+    }
+
+    /**
+     * Infix convenience to link up multiple parse_nvp actions into the
+     * table of fields for event-driven parsing.
+     */
+    template <class Ser>
+    auto operator&(sax_fields &fields, details::parse_nvp_action<Ser> &&action) -> sax_fields &;
+
+    // implementation section
+
+    inline auto sax_sink::on_null(sax_ctx &ctx) -> sax_step {
+        return on_value(ctx);
+    }
+
+    inline auto sax_sink::on_bln(sax_ctx &ctx, const dom_bln) -> sax_step {
+        return on_value(ctx);
+    }
+
+    inline auto sax_sink::on_int(sax_ctx &ctx, const dom_int) -> sax_step {
+        return on_value(ctx);
+    }
+
+    inline auto sax_sink::on_flt(sax_ctx &ctx, const dom_flt) -> sax_step {
+        return on_value(ctx);
+    }
+
+    inline auto sax_sink::on_str(sax_ctx &ctx, const char [], const size_t) -> sax_step {
+        return on_value(ctx);
+    }
+
+    inline auto sax_sink::on_start_obj(sax_ctx &ctx) -> sax_step {
+        return on_value(ctx);
+    }
+
+    inline auto sax_sink::on_key(sax_ctx &ctx, const char [], const size_t) -> sax_step {
+        return mismatch(ctx);
+    }
+
+    inline auto sax_sink::on_end_obj(sax_ctx &ctx) -> sax_step {
+        return mismatch(ctx);
+    }
+
+    inline auto sax_sink::on_start_arr(sax_ctx &ctx) -> sax_step {
+        return on_value(ctx);
+    }
+
+    inline auto sax_sink::on_end_arr(sax_ctx &ctx) -> sax_step {
+        return mismatch(ctx);
+    }
+
+    inline auto sax_sink::on_child_done(sax_ctx &) -> sax_step {
+        return sax_step::more;
+    }
+
+    inline auto sax_sink::on_value(sax_ctx &ctx) -> sax_step {
+        return mismatch(ctx);
+    }
+
+    inline auto sax_sink::mismatch(sax_ctx &ctx) -> sax_step {
+        return ctx.fail("Unexpected value while performing SAX parsing");
+    }
+
+    inline sax_ctx::sax_ctx(const bool is_insitu) :
+        insitu(is_insitu) {
+
+    }
+
+    inline auto sax_ctx::is_insitu() const -> bool {
+        return insitu;
+    }
+
+    inline void sax_ctx::push(std::unique_ptr<sax_sink> &&sink) {
+        sinks.push_back(std::move(sink));
+    }
+
+    inline void sax_ctx::reset() {
+        sinks.clear();
+        err_msg.clear();
+    }
+
+    inline auto sax_ctx::fail(std::string &&err_msg) -> sax_step {
+        this->err_msg = std::move(err_msg);
+        return sax_step::fail;
+    }
+
+    inline auto sax_ctx::get_error() const -> const std::string & {
+        return err_msg;
+    }
+
+    inline auto sax_ctx::is_done() const -> bool {
+        return sinks.empty();
+    }
+
+    inline auto sax_ctx::null() -> bool {
+        return dispatch(&sax_sink::on_null);
+    }
+
+    inline auto sax_ctx::bln(const dom_bln bln) -> bool {
+        return dispatch(&sax_sink::on_bln, bln);
+    }
+
+    inline auto sax_ctx::itg(const dom_int itg) -> bool {
+        return dispatch(&sax_sink::on_int, itg);
+    }
+
+    inline auto sax_ctx::flt(const dom_flt flt) -> bool {
+        return dispatch(&sax_sink::on_flt, flt);
+    }
+
+    inline auto sax_ctx::str(const char str[], const size_t len) -> bool {
+        return dispatch(&sax_sink::on_str, str, len);
+    }
+
+    inline auto sax_ctx::start_obj() -> bool {
+        return dispatch(&sax_sink::on_start_obj);
+    }
+
+    inline auto sax_ctx::key(const char key[], const size_t len) -> bool {
+        return dispatch(&sax_sink::on_key, key, len);
+    }
+
+    inline auto sax_ctx::end_obj() -> bool {
+        return dispatch(&sax_sink::on_end_obj);
+    }
+
+    inline auto sax_ctx::start_arr() -> bool {
+        return dispatch(&sax_sink::on_start_arr);
+    }
+
+    inline auto sax_ctx::end_arr() -> bool {
+        return dispatch(&sax_sink::on_end_arr);
+    }
+
+    template <class... Params, class... Args>
+    auto sax_ctx::dispatch(sax_step (sax_sink::*event)(sax_ctx &, Params...), Args &&... args) -> bool {
+        while (!sinks.empty()) {
+            switch ((sinks.back().get()->*event)(*this, args...)) {
+            case sax_step::more:
+                return true;
+
+            case sax_step::done:
+                return complete();
+
+            case sax_step::forward:
+                // the newly pushed child sink takes over the same event
+                break;
+
+            case sax_step::fail:
+                return false;
+            }
+        }
+
+        fail("Unexpected value after the end of the parsed value");
+        return false;
+    }
+
+    inline auto sax_ctx::complete() -> bool {
+        sinks.pop_back();
+
+        // completing a child may in turn complete its parents
+        while (!sinks.empty()) {
+            switch (sinks.back()->on_child_done(*this)) {
+            case sax_step::done:
+                sinks.pop_back();
+                break;
+
+            case sax_step::fail:
+                return false;
+
+            default:
+                return true;
+            }
+        }
+
+        return true;
+    }
+
+    namespace details {
+        template <class Ser>
+        auto sax_missing<Ser>::apply(Ser &) -> bool {
+            return false;
+        }
+
+#ifndef SERZ_DISALLOW_MISSING_ARRAY_OBJECT
+
+        template <class Ser>
+        auto sax_missing<std::vector<Ser>>::apply(std::vector<Ser> &ser) -> bool {
+            ser.clear();
+            return true;
+        }
+
+        template <class Ser>
+        auto sax_missing<std::unordered_map<std::string, Ser>>::apply(
+            std::unordered_map<std::string, Ser> &ser) -> bool {
+
+            ser.clear();
+            return true;
+        }
+
+#endif
+
+        template <class Ser>
+        auto sax_missing<::rustfp::Option<Ser>>::apply(::rustfp::Option<Ser> &ser) -> bool {
+            ser = ::rustfp::None;
+            return true;
+        }
+
+        template <class Ser>
+        auto make_sax_sink(Ser &ser) -> std::unique_ptr<sax_sink> {
+            return std::make_unique<sax_value_sink<Ser>>(ser);
+        }
+
+        template <class Ser>
+        void push_sax_field(sax_ctx &ctx, void *ser) {
+            ctx.push(make_sax_sink(*static_cast<Ser *>(ser)));
+        }
+
+        template <class Ser>
+        auto missing_sax_field(void *ser) -> bool {
+            return sax_missing<Ser>::apply(*static_cast<Ser *>(ser));
+        }
+
+        inline sax_dom_builder::sax_dom_builder(dom_val &root) :
+            root(root) {
+
+        }
+
+        inline auto sax_dom_builder::put(dom_val &&val) -> bool {
+            if (skip_depth > 0) {
+                return false;
+            }
+
+            place(std::move(val));
+            return parents.empty();
+        }
+
+        inline void sax_dom_builder::open(dom_val &&val) {
+            if (skip_depth > 0) {
+                ++skip_depth;
+                return;
+            }
+
+            const auto placed = place(std::move(val));
+
+            if (placed != nullptr) {
+                parents.push_back(placed);
+            } else {
+                skip_depth = 1;
+            }
+        }
+
+        inline void sax_dom_builder::key(const char key[], const size_t len) {
+            pending_key.assign(key, len);
+        }
+
+        inline auto sax_dom_builder::close() -> bool {
+            if (skip_depth > 0) {
+                --skip_depth;
+                return false;
+            }
+
+            parents.pop_back();
+            return parents.empty();
+        }
+
+        inline auto sax_dom_builder::place(dom_val &&val) -> dom_val * {
+            if (parents.empty()) {
+                root.get() = std::move(val);
+                return &root.get();
+            }
+
+            auto &parent = *parents.back();
+
+            if (parent.is<dom_obj>()) {
+                // same as DOM parsing, the first of any duplicated keys is kept
+                auto emplaced = parent.get_unchecked<dom_obj>().emplace(pending_key, std::move(val));
+                return emplaced.second ? &emplaced.first->second : nullptr;
+            }
+
+            auto &arr = parent.get_unchecked<dom_arr>();
+            arr.push_back(std::move(val));
+            return &arr.back();
+        }
+
+        inline auto sax_skip_sink::on_null(sax_ctx &) -> sax_step {
+            return scalar();
+        }
+
+        inline auto sax_skip_sink::on_bln(sax_ctx &, const dom_bln) -> sax_step {
+            return scalar();
+        }
+
+        inline auto sax_skip_sink::on_int(sax_ctx &, const dom_int) -> sax_step {
+            return scalar();
+        }
+
+        inline auto sax_skip_sink::on_flt(sax_ctx &, const dom_flt) -> sax_step {
+            return scalar();
+        }
+
+        inline auto sax_skip_sink::on_str(sax_ctx &, const char [], const size_t) -> sax_step {
+            return scalar();
+        }
+
+        inline auto sax_skip_sink::on_start_obj(sax_ctx &) -> sax_step {
+            ++depth;
+            return sax_step::more;
+        }
+
+        inline auto sax_skip_sink::on_key(sax_ctx &, const char [], const size_t) -> sax_step {
+            return sax_step::more;
+        }
+
+        inline auto sax_skip_sink::on_end_obj(sax_ctx &) -> sax_step {
+            return close();
+        }
+
+        inline auto sax_skip_sink::on_start_arr(sax_ctx &) -> sax_step {
+            ++depth;
+            return sax_step::more;
+        }
+
+        inline auto sax_skip_sink::on_end_arr(sax_ctx &) -> sax_step {
+            return close();
+        }
+
+        inline auto sax_skip_sink::scalar() const -> sax_step {
+            return depth == 0 ? sax_step::done : sax_step::more;
+        }
+
+        inline auto sax_skip_sink::close() -> sax_step {
+            --depth;
+            return scalar();
+        }
+
+        inline sax_path_sink::sax_path_sink(
+            const std::vector<std::string> &key_path,
+            const size_t index,
+            std::function<std::unique_ptr<sax_sink>()> make_target) :
+
+            key_path(key_path),
+            index(index),
+            make_target(std::move(make_target)) {
+
+        }
+
+        inline auto sax_path_sink::on_start_obj(sax_ctx &ctx) -> sax_step {
+            if (is_opened) {
+                return mismatch(ctx);
+            }
+
+            is_opened = true;
+            return sax_step::more;
+        }
+
+        inline auto sax_path_sink::on_key(sax_ctx &ctx, const char key[], const size_t len) -> sax_step {
+            const auto &name = key_path.get()[index];
+
+            if (!is_found && name.size() == len && std::memcmp(name.data(), key, len) == 0) {
+                is_found = true;
+
+                if (index + 1 < key_path.get().size()) {
+                    ctx.push(std::make_unique<sax_path_sink>(key_path.get(), index + 1, make_target));
+                } else {
+                    ctx.push(make_target());
+                }
+            } else {
+                ctx.push(std::make_unique<sax_skip_sink>());
+            }
+
+            return sax_step::more;
+        }
+
+        inline auto sax_path_sink::on_end_obj(sax_ctx &ctx) -> sax_step {
+            if (!is_found) {
+                return ctx.fail(fmt::format("Unable to find key with name '{}' "
+                    "while walking down the key path", key_path.get()[index]));
+            }
+
+            return sax_step::done;
+        }
+
+        inline auto sax_path_sink::mismatch(sax_ctx &ctx) -> sax_step {
+            return ctx.fail(fmt::format("Unable to interpret the DOM value as object "
+                "while walking down to key with name '{}'", key_path.get()[index]));
+        }
+
+        template <class Ser, class Fn>
+        sax_each_sink<Ser, Fn>::sax_each_sink(Fn &fn, size_t &count) :
+            fn(fn),
+            count(count) {
+
+        }
+
+        template <class Ser, class Fn>
+        auto sax_each_sink<Ser, Fn>::on_null(sax_ctx &ctx) -> sax_step {
+            if (is_opened) {
+                return on_value(ctx);
+            }
+
+            // accept null as an empty array
+            return sax_step::done;
+        }
+
+        template <class Ser, class Fn>
+        auto sax_each_sink<Ser, Fn>::on_start_arr(sax_ctx &ctx) -> sax_step {
+            if (is_opened) {
+                return on_value(ctx);
+            }
+
+            is_opened = true;
+            return sax_step::more;
+        }
+
+        template <class Ser, class Fn>
+        auto sax_each_sink<Ser, Fn>::on_end_arr(sax_ctx &) -> sax_step {
+            return sax_step::done;
+        }
+
+        template <class Ser, class Fn>
+        auto sax_each_sink<Ser, Fn>::on_child_done(sax_ctx &) -> sax_step {
+            fn.get()(std::move(elem));
+            ++count.get();
+            return sax_step::more;
+        }
+
+        template <class Ser, class Fn>
+        auto sax_each_sink<Ser, Fn>::on_value(sax_ctx &ctx) -> sax_step {
+            if (!is_opened) {
+                return mismatch(ctx);
+            }
+
+            elem = Ser();
+            ctx.push(make_sax_sink(elem));
+            return sax_step::forward;
+        }
+
+        template <class Ser, class Fn>
+        auto sax_each_sink<Ser, Fn>::mismatch(sax_ctx &ctx) -> sax_step {
+            return ctx.fail("Unable to interpret the DOM value as array");
+        }
+
+        template <class Ser, class Fn>
+        auto make_sax_each_sink(Fn &fn, size_t &count, const std::vector<std::string> &key_path) -> std::unique_ptr<sax_sink> {
+            const auto make_target = [&fn, &count]() -> std::unique_ptr<sax_sink> {
+                return std::make_unique<sax_each_sink<Ser, Fn>>(fn, count);
+            };
+
+            if (key_path.empty()) {
+                return make_target();
+            }
+
+            return std::make_unique<sax_path_sink>(key_path, 0, make_target);
+        }
+
+        template <class Ser, class Enable>
+        sax_value_sink<Ser, Enable>::sax_value_sink(Ser &ser) :
+            ser(ser),
+            builder(val) {
+
+        }
+
+        template <class Ser, class Enable>
+        auto sax_value_sink<Ser, Enable>::on_null(sax_ctx &ctx) -> sax_step {
+            return finish(ctx, builder.put(dom_null()));
+        }
+
+        template <class Ser, class Enable>
+        auto sax_value_sink<Ser, Enable>::on_bln(sax_ctx &ctx, const dom_bln bln) -> sax_step {
+            return finish(ctx, builder.put(bln));
+        }
+
+        template <class Ser, class Enable>
+        auto sax_value_sink<Ser, Enable>::on_int(sax_ctx &ctx, const dom_int itg) -> sax_step {
+            return finish(ctx, builder.put(itg));
+        }
+
+        template <class Ser, class Enable>
+        auto sax_value_sink<Ser, Enable>::on_flt(sax_ctx &ctx, const dom_flt flt) -> sax_step {
+            return finish(ctx, builder.put(flt));
+        }
+
+        template <class Ser, class Enable>
+        auto sax_value_sink<Ser, Enable>::on_str(sax_ctx &ctx, const char str[], const size_t len) -> sax_step {
+            return finish(ctx, builder.put(dom_str(str, len)));
+        }
+
+        template <class Ser, class Enable>
+        auto sax_value_sink<Ser, Enable>::on_start_obj(sax_ctx &) -> sax_step {
+            builder.open(dom_obj());
+            return sax_step::more;
+        }
+
+        template <class Ser, class Enable>
+        auto sax_value_sink<Ser, Enable>::on_key(sax_ctx &, const char key[], const size_t len) -> sax_step {
+            builder.key(key, len);
+            return sax_step::more;
+        }
+
+        template <class Ser, class Enable>
+        auto sax_value_sink<Ser, Enable>::on_end_obj(sax_ctx &ctx) -> sax_step {
+            return finish(ctx, builder.close());
+        }
+
+        template <class Ser, class Enable>
+        auto sax_value_sink<Ser, Enable>::on_start_arr(sax_ctx &) -> sax_step {
+            builder.open(dom_arr());
+            return sax_step::more;
+        }
+
+        template <class Ser, class Enable>
+        auto sax_value_sink<Ser, Enable>::on_end_arr(sax_ctx &ctx) -> sax_step {
+            return finish(ctx, builder.close());
+        }
+
+        template <class Ser, class Enable>
+        auto sax_value_sink<Ser, Enable>::finish(sax_ctx &ctx, const bool is_complete) -> sax_step {
+            if (!is_complete) {
+                return sax_step::more;
+            }
+
+            auto step = sax_step::done;
+
+            parse_value_with_msg(ser.get(), val).match_err([&ctx, &step](const std::string &err_msg) {
+                step = ctx.fail(std::string(err_msg));
+            });
+
+            return step;
+        }
+
+        inline sax_value_sink<dom_val>::sax_value_sink(dom_val &ser) :
+            builder(ser) {
+
+        }
+
+        inline auto sax_value_sink<dom_val>::on_null(sax_ctx &) -> sax_step {
+            return finish(builder.put(dom_null()));
+        }
+
+        inline auto sax_value_sink<dom_val>::on_bln(sax_ctx &, const dom_bln bln) -> sax_step {
+            return finish(builder.put(bln));
+        }
+
+        inline auto sax_value_sink<dom_val>::on_int(sax_ctx &, const dom_int itg) -> sax_step {
+            return finish(builder.put(itg));
+        }
+
+        inline auto sax_value_sink<dom_val>::on_flt(sax_ctx &, const dom_flt flt) -> sax_step {
+            return finish(builder.put(flt));
+        }
+
+        inline auto sax_value_sink<dom_val>::on_str(sax_ctx &, const char str[], const size_t len) -> sax_step {
+            return finish(builder.put(dom_str(str, len)));
+        }
+
+        inline auto sax_value_sink<dom_val>::on_start_obj(sax_ctx &) -> sax_step {
+            builder.open(dom_obj());
+            return sax_step::more;
+        }
+
+        inline auto sax_value_sink<dom_val>::on_key(sax_ctx &, const char key[], const size_t len) -> sax_step {
+            builder.key(key, len);
+            return sax_step::more;
+        }
+
+        inline auto sax_value_sink<dom_val>::on_end_obj(sax_ctx &) -> sax_step {
+            return finish(builder.close());
+        }
+
+        inline auto sax_value_sink<dom_val>::on_start_arr(sax_ctx &) -> sax_step {
+            builder.open(dom_arr());
+            return sax_step::more;
+        }
+
+        inline auto sax_value_sink<dom_val>::on_end_arr(sax_ctx &) -> sax_step {
+            return finish(builder.close());
+        }
+
+        inline auto sax_value_sink<dom_val>::finish(const bool is_complete) -> sax_step {
+            return is_complete ? sax_step::done : sax_step::more;
+        }
+
+        inline sax_value_sink<std::string>::sax_value_sink(std::string &ser) :
+            ser(ser) {
+
+        }
+
+        inline auto sax_value_sink<std::string>::on_null(sax_ctx &) -> sax_step {
+            // same as DOM parsing, accepting null as an empty string
+            ser.get().clear();
+            return sax_step::done;
+        }
+
+        inline auto sax_value_sink<std::string>::on_str(sax_ctx &, const char str[], const size_t len) -> sax_step {
+            ser.get().assign(str, len);
+            return sax_step::done;
+        }
+
+        inline auto sax_value_sink<std::string>::mismatch(sax_ctx &ctx) -> sax_step {
+            return ctx.fail("Unable to interpret the DOM value as string");
+        }
+
+        inline sax_value_sink<str_ref>::sax_value_sink(str_ref &ser) :
+            ser(ser) {
+
+        }
+
+        inline auto sax_value_sink<str_ref>::on_null(sax_ctx &) -> sax_step {
+            ser.get() = str_ref();
+            return sax_step::done;
+        }
+
+        inline auto sax_value_sink<str_ref>::on_str(sax_ctx &ctx, const char str[], const size_t len) -> sax_step {
+            // only in-situ string values outlive the parsing itself
+            if (!ctx.is_insitu()) {
+                return ctx.fail("Unable to borrow string value outside of in-situ parsing");
+            }
+
+            ser.get() = str_ref(str, len);
+            return sax_step::done;
+        }
+
+        inline auto sax_value_sink<str_ref>::mismatch(sax_ctx &ctx) -> sax_step {
+            return ctx.fail("Unable to interpret the DOM value as string");
+        }
+
+        template <class Ser>
+        sax_value_sink<std::vector<Ser>>::sax_value_sink(std::vector<Ser> &sers) :
+            sers(sers),
+            is_reuse(get_parse_mode() == parse_mode::reuse) {
+
+        }
+
+        template <class Ser>
+        auto sax_value_sink<std::vector<Ser>>::on_null(sax_ctx &ctx) -> sax_step {
+            if (is_opened) {
+                return on_value(ctx);
+            }
+
+            // accept null as an empty vector
+            sers.get().clear();
+            return sax_step::done;
+        }
+
+        template <class Ser>
+        auto sax_value_sink<std::vector<Ser>>::on_start_arr(sax_ctx &ctx) -> sax_step {
+            if (is_opened) {
+                return on_value(ctx);
+            }
+
+            is_opened = true;
+            return sax_step::more;
+        }
+
+        template <class Ser>
+        auto sax_value_sink<std::vector<Ser>>::on_end_arr(sax_ctx &) -> sax_step {
+            if (is_reuse) {
+                // drops the elements beyond the incoming ones
+                sers.get().resize(count);
+            }
+
+            return sax_step::done;
+        }
+
+        template <class Ser>
+        auto sax_value_sink<std::vector<Ser>>::on_child_done(sax_ctx &) -> sax_step {
+            return is_single ? sax_step::done : sax_step::more;
+        }
+
+        template <class Ser>
+        auto sax_value_sink<std::vector<Ser>>::on_value(sax_ctx &ctx) -> sax_step {
+            if (!is_opened) {
+                // otherwise simply accept as a single value vector,
+                // keeping the first element to parse into when reusing
+                if (is_reuse) {
+                    sers.get().resize(1);
+                } else {
+                    sers.get().clear();
+                }
+
+                is_single = true;
+            }
+
+            if (is_reuse && count < sers.get().size()) {
+                ctx.push(make_sax_sink(sers.get()[count]));
+            } else {
+                sers.get().emplace_back();
+                ctx.push(make_sax_sink(sers.get().back()));
+            }
+
+            ++count;
+            return sax_step::forward;
+        }
+
+        template <class Ser>
+        sax_value_sink<std::unordered_map<std::string, Ser>>::sax_value_sink(
+            std::unordered_map<std::string, Ser> &sers) :
+
+            sers(sers),
+            is_reuse(get_parse_mode() == parse_mode::reuse) {
+
+        }
+
+        template <class Ser>
+        auto sax_value_sink<std::unordered_map<std::string, Ser>>::on_null(sax_ctx &) -> sax_step {
+            // accept null as an empty unordered_map
+            sers.get().clear();
+            return sax_step::done;
+        }
+
+        template <class Ser>
+        auto sax_value_sink<std::unordered_map<std::string, Ser>>::on_start_obj(sax_ctx &) -> sax_step {
+            return sax_step::more;
+        }
+
+        template <class Ser>
+        auto sax_value_sink<std::unordered_map<std::string, Ser>>::on_key(
+            sax_ctx &ctx, const char key[], const size_t len) -> sax_step {
+
+            key_buf.assign(key, len);
+            auto it = sers.get().find(key_buf);
+
+            if (it == sers.get().end()) {
+                it = sers.get().emplace(
+                    std::piecewise_construct,
+                    std::forward_as_tuple(key_buf),
+                    std::forward_as_tuple()).first;
+            }
+
+            // same as DOM parsing, the first of any duplicated keys is kept,
+            // where keys are stored in nodes, so their addresses stay put
+            if (!seen_keys.insert(&it->first).second) {
+                ctx.push(std::make_unique<sax_skip_sink>());
+            } else {
+                ctx.push(make_sax_sink(it->second));
+            }
+
+            return sax_step::more;
+        }
+
+        template <class Ser>
+        auto sax_value_sink<std::unordered_map<std::string, Ser>>::on_end_obj(sax_ctx &) -> sax_step {
+            // drops the entries of keys that did not come in
+            if (is_reuse && sers.get().size() > seen_keys.size()) {
+                for (auto it = sers.get().begin(); it != sers.get().end();) {
+                    if (seen_keys.count(&it->first) == 0) {
+                        it = sers.get().erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+
+            return sax_step::done;
+        }
+
+        template <class Ser>
+        auto sax_value_sink<std::unordered_map<std::string, Ser>>::mismatch(sax_ctx &ctx) -> sax_step {
+            return ctx.fail("Unable to interpret the DOM value as object");
+        }
+
+        template <class Ser>
+        sax_value_sink<::rustfp::Option<Ser>>::sax_value_sink(::rustfp::Option<Ser> &ser) :
+            ser(ser) {
+
+        }
+
+        template <class Ser>
+        auto sax_value_sink<::rustfp::Option<Ser>>::on_child_done(sax_ctx &) -> sax_step {
+            if (!is_in_place) {
+                ser.get() = ::rustfp::Some(std::move(inner));
+            }
+
+            return sax_step::done;
+        }
+
+        template <class Ser>
+        auto sax_value_sink<::rustfp::Option<Ser>>::on_value(sax_ctx &ctx) -> sax_step {
+            // parses into the existing value if there is one to reuse
+            is_in_place = get_parse_mode() == parse_mode::reuse && ser.get().is_some();
+            ctx.push(make_sax_sink(is_in_place ? ser.get().get_mut_unchecked() : inner));
+            return sax_step::forward;
+        }
+
+        template <class Ser>
+        sax_value_sink<Ser, std::enable_if_t<has_parse_fields<Ser>::value>>::sax_value_sink(Ser &ser) :
+            ser(ser) {
+
+        }
+
+        template <class Ser>
+        auto sax_value_sink<Ser, std::enable_if_t<has_parse_fields<Ser>::value>>::on_start_obj(
+            sax_ctx &) -> sax_step {
+
+            parse_fields(ser.get(), fields);
+            return sax_step::more;
+        }
+
+        template <class Ser>
+        auto sax_value_sink<Ser, std::enable_if_t<has_parse_fields<Ser>::value>>::on_key(
+            sax_ctx &ctx, const char key[], const size_t len) -> sax_step {
+
+            const auto field = fields.find(key, len);
+
+            // same as DOM parsing, the first of any duplicated keys is kept
+            if (field && !field->seen) {
+                field->seen = true;
+                field->push(ctx, field->ser);
+            } else {
+                ctx.push(std::make_unique<sax_skip_sink>());
+            }
+
+            return sax_step::more;
+        }
+
+        template <class Ser>
+        auto sax_value_sink<Ser, std::enable_if_t<has_parse_fields<Ser>::value>>::on_end_obj(
+            sax_ctx &ctx) -> sax_step {
+
+            return fields.complete(ctx);
+        }
+
+        template <class Ser>
+        auto sax_value_sink<Ser, std::enable_if_t<has_parse_fields<Ser>::value>>::mismatch(
+            sax_ctx &ctx) -> sax_step {
+
+            return ctx.fail("Unable to interpret DOM value as DOM object");
+        }
+    }
+
+    template <class Ser>
+    auto sax_fields::add(Ser &ser, const str_ref &name) -> sax_fields & {
+        // owns the name, since the table outlives the chain that adds the fields
+        fields.push_back(details::sax_field{
+            name.to_string(),
+            &ser,
+            &details::push_sax_field<Ser>,
+            &details::missing_sax_field<Ser>,
+            false});
+
+        return *this;
+    }
+
+    inline auto sax_fields::find(const char key[], const size_t len) -> details::sax_field * {
+        const auto count = fields.size();
+
+        for (size_t offset = 0; offset < count; ++offset) {
+            const auto index = (hint + offset) % count;
+            auto &field = fields[index];
+
+            if (field.name.size() == len && std::memcmp(field.name.data(), key, len) == 0) {
+                hint = index + 1;
+                return &field;
+            }
+        }
+
+        return nullptr;
+    }
+
+    inline auto sax_fields::complete(sax_ctx &ctx) -> sax_step {
+        for (auto &field : fields) {
+            if (!field.seen && !field.missing(field.ser)) {
+                return ctx.fail(fmt::format("Unable to find key with name '{}' "
+                    "while performing parse_nvp", field.name));
+            }
+        }
+
+        return sax_step::done;
+    }
+
+    template <class Ser>
+    auto operator&(sax_fields &fields, details::parse_nvp_action<Ser> &&action) -> sax_fields & {
+        return fields.add(action.get_ser(), action.get_name());
+    }
+}
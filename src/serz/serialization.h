@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include "error.h"
+#include "str_ref.h"
 #include "val.h"
 #include "traits.h"
 
@@ -24,6 +26,7 @@
 #include <functional>
 #include <limits>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -32,18 +35,121 @@
 namespace serz {
     // declaration section
 
+    /**
+     * Position within a DOM object that is carried along a chain of parse_nvp
+     * actions. Since keys mostly come in the same order as the fields are
+     * declared, each name is first compared against the member right after
+     * the previous match, and only looked up by hash when that misses, so
+     * that an ordered object is matched in a single walk.
+     */
+    class dom_obj_cursor {
+    public:
+        /**
+         * Initializes the cursor at the first member of the given DOM object.
+         */
+        explicit dom_obj_cursor(const dom_obj &obj);
+
+        /**
+         * Finds the member with the given name, and moves the cursor past it
+         * if found. Returns iterator that points to end if no such name was found.
+         */
+        auto find(const str_ref &name) -> dom_obj::const_iterator;
+
+        /**
+         * Gets the DOM object.
+         */
+        auto get_obj() const -> const dom_obj &;
+
+        /**
+         * Allows the cursor to be taken as the DOM object.
+         */
+        operator const dom_obj &() const;
+
+    private:
+        /**
+         * DOM object being matched.
+         */
+        std::reference_wrapper<const dom_obj> obj;
+
+        /**
+         * Member after the previous match.
+         */
+        dom_obj::const_iterator next;
+    };
+
+    /**
+     * How parsing treats the value that is parsed into.
+     */
+    enum class parse_mode {
+        /**
+         * Vectors are appended to, entries of maps already present are kept,
+         * and optional values are only replaced once parsed successfully.
+         */
+        append,
+
+        /**
+         * Vectors and maps are resized to the incoming size, and the existing
+         * elements, entries, optional values and string buffers are parsed
+         * into, so that repeatedly parsing similarly shaped values into the
+         * same object stops allocating for it. On failure, the value is left
+         * partially parsed.
+         */
+        reuse,
+    };
+
+    /**
+     * Sets the parse mode of the current thread for its lifetime,
+     * and restores the previous parse mode after.
+     */
+    class parse_mode_scope {
+    public:
+        /**
+         * Sets the parse mode of the current thread.
+         */
+        explicit parse_mode_scope(const parse_mode mode);
+
+        parse_mode_scope(const parse_mode_scope &) = delete;
+        auto operator=(const parse_mode_scope &) -> parse_mode_scope & = delete;
+
+        /**
+         * Restores the previous parse mode of the current thread.
+         */
+        ~parse_mode_scope();
+
+    private:
+        /**
+         * Parse mode before this scope.
+         */
+        parse_mode prev;
+    };
+
+    /**
+     * Gets the parse mode of the current thread, which is parse_mode::append
+     * unless within a parse_mode_scope.
+     */
+    auto get_parse_mode() -> parse_mode;
+
     namespace details {
+        /**
+         * Holds the parse mode of the current thread.
+         */
+        auto parse_mode_state() -> parse_mode &;
+
         template <class Ser>
         class parse_nvp_action {
         public:
-            parse_nvp_action(Ser &ser, const std::string &name);
+            parse_nvp_action(Ser &ser, const str_ref &name);
+
+            auto operator()(::rustfp::Result<dom_obj_cursor, parse_error> &&obj_res) ->
+                ::rustfp::Result<dom_obj_cursor, parse_error>;
 
-            auto operator()(::rustfp::Result<const dom_obj &, std::string> &&obj_res) ->
-                ::rustfp::Result<const dom_obj &, std::string>;
+            auto get_ser() const -> Ser &;
+
+            auto get_name() const -> const str_ref &;
 
         private:
             std::reference_wrapper<Ser> ser;
-            std::string name;
+            str_ref name;
         };
 
 #ifndef SERZ_DISALLOW_MISSING_ARRAY_OBJECT
@@ -51,27 +157,35 @@ namespace serz {
         template <class Ser>
         class parse_nvp_action<std::vector<Ser>> {
         public:
-            parse_nvp_action(std::vector<Ser> &ser, const std::string &name);
+            parse_nvp_action(std::vector<Ser> &ser, const str_ref &name);
+
+            auto operator()(::rustfp::Result<dom_obj_cursor, parse_error> &&obj_res) ->
+                ::rustfp::Result<dom_obj_cursor, parse_error>;
 
-            auto operator()(::rustfp::Result<const dom_obj &, std::string> &&obj_res) ->
-                ::rustfp::Result<const dom_obj &, std::string>;
+            auto get_ser() const -> std::vector<Ser> &;
+
+            auto get_name() const -> const str_ref &;
 
         private:
             std::reference_wrapper<std::vector<Ser>> ser;
-            std::string name;
+            str_ref name;
         };
 
         template <class Ser>
         class parse_nvp_action<std::unordered_map<std::string, Ser>> {
         public:
-            parse_nvp_action(std::unordered_map<std::string, Ser> &ser, const std::string &name);
+            parse_nvp_action(std::unordered_map<std::string, Ser> &ser, const str_ref &name);
+
+            auto operator()(::rustfp::Result<dom_obj_cursor, parse_error> &&obj_res) ->
+                ::rustfp::Result<dom_obj_cursor, parse_error>;
+
+            auto get_ser() const -> std::unordered_map<std::string, Ser> &;
 
-            auto operator()(::rustfp::Result<const dom_obj &, std::string> &&obj_res) ->
-                ::rustfp::Result<const dom_obj &, std::string>;
+            auto get_name() const -> const str_ref &;
 
         private:
             std::reference_wrapper<std::unordered_map<std::string, Ser>> ser;
-            std::string name;
+            str_ref name;
         };
 
 #endif
@@ -79,14 +193,18 @@ namespace serz {
         template <class Ser>
         class parse_nvp_action<::rustfp::Option<Ser>> {
         public:
-            parse_nvp_action(::rustfp::Option<Ser> &ser, const std::string &name);
+            parse_nvp_action(::rustfp::Option<Ser> &ser, const str_ref &name);
+
+            auto operator()(::rustfp::Result<dom_obj_cursor, parse_error> &&obj_res) ->
+                ::rustfp::Result<dom_obj_cursor, parse_error>;
+
+            auto get_ser() const -> ::rustfp::Option<Ser> &;
 
-            auto operator()(::rustfp::Result<const dom_obj &, std::string> &&obj_res) ->
-                ::rustfp::Result<const dom_obj &, std::string>;
+            auto get_name() const -> const str_ref &;
 
         private:
             std::reference_wrapper<::rustfp::Option<Ser>> ser;
-            std::string name;
+            str_ref name;
         };
 
         template <class Ser>
@@ -94,14 +212,14 @@ namespace serz {
         public:
             serialize_nvp_action(
                 const Ser &ser,
-                const std::string &name,
+                const str_ref &name,
                 const bool is_attr = false);
 
             auto operator()(dom_obj &obj) -> dom_obj &;
 
         private:
             std::reference_wrapper<const Ser> ser;
-            std::string name;
+            str_ref name;
             bool is_attr;
         };
     
@@ -110,14 +228,14 @@ namespace serz {
         public:
             serialize_nvp_action(
                 const ::rustfp::Option<Ser> &ser,
-                const std::string &name,
+                const str_ref &name,
                 const bool is_attr = false);
 
             auto operator()(dom_obj &obj) -> dom_obj &;
 
         private:
             std::reference_wrapper<const ::rustfp::Option<Ser>> ser;
-            std::string name;
+            str_ref name;
             bool is_attr;
         };
 
@@ -126,8 +244,8 @@ namespace serz {
         public:
             done_obj_action(Ser &ser);
 
-            auto operator()(::rustfp::Result<const dom_obj &, std::string> &&obj_res) ->
-                ::rustfp::Result<Ser &, std::string>;
+            auto operator()(::rustfp::Result<dom_obj_cursor, parse_error> &&obj_res) ->
+                parse_result<Ser>;
 
         private:
             std::reference_wrapper<Ser> ser;
@@ -141,15 +259,69 @@ namespace serz {
 
         template <class DomType, class Num>
         auto parse_value_number_impl(Num &ser, const dom_val &val) ->
-            ::rustfp::Result<Num &, std::string>;
+            ::rustfp::Result<Num &, parse_error>;
 
         template <class Int>
         auto parse_value_int_impl(Int &ser, const dom_val &val) ->
-            ::rustfp::Result<Int &, std::string>;
+            ::rustfp::Result<Int &, parse_error>;
 
         template <class Flt>
         auto parse_value_flt_impl(Flt &ser, const dom_val &val) ->
-            ::rustfp::Result<Flt &, std::string>;
+            ::rustfp::Result<Flt &, parse_error>;
+
+        /**
+         * Parses the DOM value straight into a new element at the back of the vector,
+         * which is removed again on failure.
+         */
+        template <class Ser>
+        auto parse_emplace_back(std::vector<Ser> &sers, const dom_val &val) ->
+            ::rustfp::Result<::rustfp::unit_t, parse_error>;
+
+        /**
+         * Same as above parse_emplace_back, except parses into a temporary first,
+         * since the elements of std::vector<bool> cannot be referred to.
+         */
+        auto parse_emplace_back(std::vector<bool> &sers, const dom_val &val) ->
+            ::rustfp::Result<::rustfp::unit_t, parse_error>;
+
+        /**
+         * Parses the DOM value straight into the existing element at the given index.
+         */
+        template <class Ser>
+        auto parse_at(std::vector<Ser> &sers, const size_t index, const dom_val &val) ->
+            ::rustfp::Result<::rustfp::unit_t, parse_error>;
+
+        /**
+         * Same as above parse_at, except parses into a temporary first,
+         * since the elements of std::vector<bool> cannot be referred to.
+         */
+        auto parse_at(std::vector<bool> &sers, const size_t index, const dom_val &val) ->
+            ::rustfp::Result<::rustfp::unit_t, parse_error>;
+
+        /**
+         * Parses the DOM array into the vector in parse_mode::reuse,
+         * resizing the vector to the array and parsing into its existing elements.
+         */
+        template <class Ser>
+        auto parse_reuse_elems(std::vector<Ser> &sers, const dom_arr &arr) ->
+            ::rustfp::Result<std::vector<Ser> &, parse_error>;
+
+        /**
+         * Parses the DOM object into the unordered_map in parse_mode::reuse,
+         * parsing into the entries of keys already present and erasing
+         * the entries of keys that are not in the DOM object.
+         */
+        template <class Ser>
+        auto parse_reuse_entries(std::unordered_map<std::string, Ser> &sers, const dom_obj &obj) ->
+            ::rustfp::Result<std::unordered_map<std::string, Ser> &, parse_error>;
+
+        /**
+         * Parses the DOM value, formatting any failure into its message
+         * for the interfaces that report failures as strings.
+         */
+        template <class Ser>
+        auto parse_value_with_msg(Ser &ser, const dom_val &val) ->
+            ::rustfp::Result<Ser &, std::string>;
 
         template <class Ser, bool = std::is_enum<Ser>::value>
         struct parse_value_enum_impl;
@@ -157,13 +329,13 @@ namespace serz {
         template <class Ser>
         struct parse_value_enum_impl<Ser, false> {
             static auto exec(Ser &ser, const dom_val &val) ->
-                ::rustfp::Result<Ser &, std::string>;
+                ::rustfp::Result<Ser &, parse_error>;
         };
 
         template <class Enum>
         struct parse_value_enum_impl<Enum, true> {
             static auto exec(Enum &ser, const dom_val &val) ->
-                ::rustfp::Result<Enum &, std::string>;
+                ::rustfp::Result<Enum &, parse_error>;
         };
 
         template <class Ser, bool = std::is_enum<Ser>::value>
@@ -298,18 +470,18 @@ namespace serz {
      */
     template <class Ser>
     auto operator&(
-        ::rustfp::Result<const dom_obj &, std::string> &&obj_res,
+        ::rustfp::Result<dom_obj_cursor, parse_error> &&obj_res,
         details::parse_nvp_action<Ser> &&action) ->
-        ::rustfp::Result<const dom_obj &, std::string>;
+        ::rustfp::Result<dom_obj_cursor, parse_error>;
 
     /**
      * Infix convenience to link up the last parse_nvp to done_obj action.
      */
     template <class Ser>
     auto operator&(
-        ::rustfp::Result<const dom_obj &, std::string> &&obj_res,
+        ::rustfp::Result<dom_obj_cursor, parse_error> &&obj_res,
         details::done_obj_action<Ser> &&action) ->
-        ::rustfp::Result<Ser &, std::string>;
+        parse_result<Ser>;
 
     /**
      * Infix convenience to link up multiple serialize_nvp actions.
@@ -321,8 +493,9 @@ namespace serz {
     /**
      * Provides starting convenience to monadically get dom_obj out of dom_val,
      * allowing the result to chain with parse_nvp and end with done_obj.
+     * The chain shares a cursor into the dom_obj to match ordered keys cheaply.
      */
-    auto as_obj(const dom_val &val) -> ::rustfp::Result<const dom_obj &, std::string>;
+    auto as_obj(const dom_val &val) -> ::rustfp::Result<dom_obj_cursor, parse_error>;
 
     /**
      * Provides ending convenience to end the parsing chain of parse_nvp
@@ -339,10 +512,12 @@ namespace serz {
 
     /**
      * Creates an action to DOM serialization for parsing DOM value
-     * in DOM object.
+     * in DOM object. The name is only referenced, and must outlive the action,
+     * which holds for string literals and for names used within the same chain.
+     * The field table of SAX parsing takes a copy of the name.
      */
     template <class Ser>
-    auto parse_nvp(Ser &ser, const std::string &name) ->
+    auto parse_nvp(Ser &ser, const str_ref &name) ->
         details::parse_nvp_action<Ser>;
 
     /**
@@ -352,91 +527,91 @@ namespace serz {
      */
     template <class Ser>
     auto parse_value(Ser &ser, const dom_val &val) ->
-        ::rustfp::Result<Ser &, std::string>;
+        parse_result<Ser>;
 
     /**
      * Provides parsing implementation for bool.
      */
     auto parse_value(::rustfp::unit_t &ser, const dom_val &val) ->
-        ::rustfp::Result<::rustfp::unit_t &, std::string>;
+        parse_result<::rustfp::unit_t>;
 
     /**
      * Provides parsing implementation for bool.
      */
     auto parse_value(bool &ser, const dom_val &val) ->
-        ::rustfp::Result<bool &, std::string>;
+        parse_result<bool>;
 
     /**
      * Provides parsing implementation for int8_t.
      */
     auto parse_value(int8_t &ser, const dom_val &val) ->
-        ::rustfp::Result<int8_t &, std::string>;
+        parse_result<int8_t>;
 
     /**
      * Provides parsing implementation for int16_t.
      */
     auto parse_value(int16_t &ser, const dom_val &val) ->
-        ::rustfp::Result<int16_t &, std::string>;
+        parse_result<int16_t>;
 
     /**
      * Provides parsing implementation for int32_t.
      */
     auto parse_value(int32_t &ser, const dom_val &val) ->
-        ::rustfp::Result<int32_t &, std::string>;
+        parse_result<int32_t>;
 
     /**
      * Provides parsing implementation for int64_t.
      */
     auto parse_value(int64_t &ser, const dom_val &val) ->
-        ::rustfp::Result<int64_t &, std::string>;
+        parse_result<int64_t>;
 
     /**
      * Provides parsing implementation for uint8_t.
      */
     auto parse_value(uint8_t &ser, const dom_val &val) ->
-        ::rustfp::Result<uint8_t &, std::string>;
+        parse_result<uint8_t>;
 
     /**
      * Provides parsing implementation for uint16_t.
      */
     auto parse_value(uint16_t &ser, const dom_val &val) ->
-        ::rustfp::Result<uint16_t &, std::string>;
+        parse_result<uint16_t>;
 
     /**
      * Provides parsing implementation for uint32_t.
      */
     auto parse_value(uint32_t &ser, const dom_val &val) ->
-        ::rustfp::Result<uint32_t &, std::string>;
+        parse_result<uint32_t>;
 
     /**
      * Provides parsing implementation for uint64_t.
      */
     auto parse_value(uint64_t &ser, const dom_val &val) ->
-        ::rustfp::Result<uint64_t &, std::string>;
+        parse_result<uint64_t>;
 
     /**
      * Provides parsing implementation for float.
      */
     auto parse_value(float &ser, const dom_val &val) ->
-        ::rustfp::Result<float &, std::string>;
+        parse_result<float>;
 
     /**
      * Provides parsing implementation for double.
      */
     auto parse_value(double &ser, const dom_val &val) ->
-        ::rustfp::Result<double &, std::string>;
+        parse_result<double>;
 
     /**
      * Provides parsing implementation for std::string.
      */
     auto parse_value(std::string &ser, const dom_val &val) ->
-        ::rustfp::Result<std::string &, std::string>;
+        parse_result<std::string>;
 
     /**
      * Provides parsing implementation for dom_val;
      */
     auto parse_value(dom_val &ser, const dom_val &val) ->
-        ::rustfp::Result<dom_val &, std::string>;
+        parse_result<dom_val>;
 
     /**
      * Provides parsing implementation for std::vector<Ser>,
@@ -444,7 +619,7 @@ namespace serz {
      */
     template <class Ser>
     auto parse_value(std::vector<Ser> &sers, const dom_val &val) ->
-        ::rustfp::Result<std::vector<Ser> &, std::string>;
+        parse_result<std::vector<Ser>>;
 
     /**
      * Provides parsing implementation for
@@ -452,7 +627,7 @@ namespace serz {
      */
     template <class Ser>
     auto parse_value(std::unordered_map<std::string, Ser> &sers, const dom_val &val) ->
-        ::rustfp::Result<std::unordered_map<std::string, Ser> &, std::string>;
+        parse_result<std::unordered_map<std::string, Ser>>;
 
     /**
      * Provides parsing implementation for
@@ -460,7 +635,7 @@ namespace serz {
      */
     template <class Ser>
     auto parse_value(::rustfp::Option<Ser> &ser, const dom_val &val) ->
-        ::rustfp::Result<::rustfp::Option<Ser> &, std::string>;
+        parse_result<::rustfp::Option<Ser>>;
 
     /**
      * Creates an action to DOM serialization for serializing
@@ -468,12 +643,12 @@ namespace serz {
      * because this would cause the child node for XML serialization
      * to have blank node names. Otherwise it is okay for use for other
      * format types like JSON. Allows marking the DOM value as an XML
-     * attribute also.
+     * attribute also. The name is only referenced until the action runs.
      */
     template <class Ser>
     auto serialize_nvp(
         const Ser &ser,
-        const std::string &name,
+        const str_ref &name,
         const bool is_attr = false) ->
         details::serialize_nvp_action<Ser>;
 
@@ -550,6 +725,11 @@ namespace serz {
      */
     auto serialize_value(const std::string &ser, dom_val &val) -> dom_val &;
 
+    /**
+     * Provides serializing implementation for str_ref.
+     */
+    auto serialize_value(const str_ref &ser, dom_val &val) -> dom_val &;
+
     /**
      * Provides serializing implementation for dom_val.
      */
@@ -579,9 +759,56 @@ namespace serz {
 
     // implementation section
 
+    inline dom_obj_cursor::dom_obj_cursor(const dom_obj &obj) :
+        obj(obj),
+        next(obj.cbegin()) {
+
+    }
+
+    inline auto dom_obj_cursor::find(const str_ref &name) -> dom_obj::const_iterator {
+        // the member after the previous match is the most likely one
+        const auto it = next != obj.get().cend() && details::insert_map_key_eq(next->first, name)
+            ? next
+            : obj.get().find(name);
+
+        if (it != obj.get().cend()) {
+            next = it;
+            ++next;
+        }
+
+        return it;
+    }
+
+    inline auto dom_obj_cursor::get_obj() const -> const dom_obj & {
+        return obj.get();
+    }
+
+    inline dom_obj_cursor::operator const dom_obj &() const {
+        return get_obj();
+    }
+
+    inline parse_mode_scope::parse_mode_scope(const parse_mode mode) :
+        prev(details::parse_mode_state()) {
+
+        details::parse_mode_state() = mode;
+    }
+
+    inline parse_mode_scope::~parse_mode_scope() {
+        details::parse_mode_state() = prev;
+    }
+
+    inline auto get_parse_mode() -> parse_mode {
+        return details::parse_mode_state();
+    }
+
     namespace details {
+        inline auto parse_mode_state() -> parse_mode & {
+            static thread_local parse_mode mode = parse_mode::append;
+            return mode;
+        }
+
         template <class Ser>
-        parse_nvp_action<Ser>::parse_nvp_action(Ser &ser, const std::string &name) :
+        parse_nvp_action<Ser>::parse_nvp_action(Ser &ser, const str_ref &name) :
             ser(ser),
             name(name) {
 
@@ -589,28 +816,39 @@ namespace serz {
 
         template <class Ser>
         auto parse_nvp_action<Ser>::operator()(
-            ::rustfp::Result<const dom_obj &, std::string> &&obj_res) ->
-            ::rustfp::Result<const dom_obj &, std::string> {
+            ::rustfp::Result<dom_obj_cursor, parse_error> &&obj_res) ->
+            ::rustfp::Result<dom_obj_cursor, parse_error> {
 
-            return std::move(obj_res).and_then([this](const dom_obj &obj) {
-                const auto it = obj.find(name);
+            return std::move(obj_res).and_then([this](dom_obj_cursor cursor) {
+                const auto it = cursor.find(name);
 
-                return (it != obj.cend())
-                    ? parse_value(ser.get(), it->second)
-                        .map([&obj](Ser &) { return std::cref(obj); })
+                return (it != cursor.get_obj().cend())
+                    ? as_parse_result(parse_value(ser.get(), it->second))
+                        .map([&cursor](Ser &) { return cursor; })
+                        .map_err([this](parse_error err) { return std::move(err.prepend_key(name)); })
 
-                    : ::rustfp::Err(
-                        fmt::format("Unable to find key with name '{}' "
-                            "while performing parse_nvp", name));
+                    : ::rustfp::Err(std::move(
+                        parse_error(parse_errc::missing_key, dom_val_type::null_type, dom_val_type::null_type)
+                            .prepend_key(name)));
             });
         }
 
+        template <class Ser>
+        auto parse_nvp_action<Ser>::get_ser() const -> Ser & {
+            return ser.get();
+        }
+
+        template <class Ser>
+        auto parse_nvp_action<Ser>::get_name() const -> const str_ref & {
+            return name;
+        }
+
 #ifndef SERZ_DISALLOW_MISSING_ARRAY_OBJECT
 
         template <class Ser>
         parse_nvp_action<std::vector<Ser>>::parse_nvp_action(
             std::vector<Ser> &ser,
-            const std::string &name) :
+            const str_ref &name) :
 
             ser(ser),
             name(name) {
@@ -619,28 +857,39 @@ namespace serz {
 
         template <class Ser>
         auto parse_nvp_action<std::vector<Ser>>::operator()(
-            ::rustfp::Result<const dom_obj &, std::string> &&obj_res) ->
-            ::rustfp::Result<const dom_obj &, std::string> {
+            ::rustfp::Result<dom_obj_cursor, parse_error> &&obj_res) ->
+            ::rustfp::Result<dom_obj_cursor, parse_error> {
 
-            return std::move(obj_res).and_then([this](const dom_obj &obj) {
+            return std::move(obj_res).and_then([this](dom_obj_cursor cursor) {
                 // alter the behaviour here to not necessary to find the name
-                const auto it = obj.find(name);
+                const auto it = cursor.find(name);
 
-                return (it != obj.cend())
-                    ? parse_value(ser.get(), it->second)
-                        .map([&obj](std::vector<Ser> &) { return std::ref(obj); })
+                return (it != cursor.get_obj().cend())
+                    ? as_parse_result(parse_value(ser.get(), it->second))
+                        .map([&cursor](std::vector<Ser> &) { return cursor; })
+                        .map_err([this](parse_error err) { return std::move(err.prepend_key(name)); })
 
-                    : [this, &obj] {
+                    : [this, &cursor] {
                         ser.get().clear();
-                        return ::rustfp::Ok(std::cref(obj));
+                        return ::rustfp::Ok(cursor);
                     }();
             });
         }
 
+        template <class Ser>
+        auto parse_nvp_action<std::vector<Ser>>::get_ser() const -> std::vector<Ser> & {
+            return ser.get();
+        }
+
+        template <class Ser>
+        auto parse_nvp_action<std::vector<Ser>>::get_name() const -> const str_ref & {
+            return name;
+        }
+
         template <class Ser>
         parse_nvp_action<std::unordered_map<std::string, Ser>>::parse_nvp_action(
             std::unordered_map<std::string, Ser> &ser,
-            const std::string &name) :
+            const str_ref &name) :
 
             ser(ser),
             name(name) {
@@ -649,30 +898,41 @@ namespace serz {
 
         template <class Ser>
         auto parse_nvp_action<std::unordered_map<std::string, Ser>>::operator()(
-            ::rustfp::Result<const dom_obj &, std::string> &&obj_res) ->
-            ::rustfp::Result<const dom_obj &, std::string> {
+            ::rustfp::Result<dom_obj_cursor, parse_error> &&obj_res) ->
+            ::rustfp::Result<dom_obj_cursor, parse_error> {
 
-            return std::move(obj_res).and_then([this](const dom_obj &obj) {
+            return std::move(obj_res).and_then([this](dom_obj_cursor cursor) {
                 // alter the behaviour here to not necessary to find the name
-                const auto it = obj.find(name);
+                const auto it = cursor.find(name);
 
-                return (it != obj.cend())
-                    ? parse_value(ser.get(), it->second)
-                        .map([&obj](std::unordered_map<std::string, Ser> &) { return std::cref(obj); })
+                return (it != cursor.get_obj().cend())
+                    ? as_parse_result(parse_value(ser.get(), it->second))
+                        .map([&cursor](std::unordered_map<std::string, Ser> &) { return cursor; })
+                        .map_err([this](parse_error err) { return std::move(err.prepend_key(name)); })
 
-                    : [this, &obj] {
+                    : [this, &cursor] {
                         ser.get().clear();
-                        return ::rustfp::Ok(std::cref(obj));
+                        return ::rustfp::Ok(cursor);
                     }();
             });
         }
 
+        template <class Ser>
+        auto parse_nvp_action<std::unordered_map<std::string, Ser>>::get_ser() const -> std::unordered_map<std::string, Ser> & {
+            return ser.get();
+        }
+
+        template <class Ser>
+        auto parse_nvp_action<std::unordered_map<std::string, Ser>>::get_name() const -> const str_ref & {
+            return name;
+        }
+
 #endif
 
         template <class Ser>
         parse_nvp_action<::rustfp::Option<Ser>>::parse_nvp_action(
             ::rustfp::Option<Ser> &ser,
-            const std::string &name) :
+            const str_ref &name) :
 
             ser(ser),
             name(name) {
@@ -681,28 +941,39 @@ namespace serz {
 
         template <class Ser>
         auto parse_nvp_action<::rustfp::Option<Ser>>::operator()(
-            ::rustfp::Result<const dom_obj &, std::string> &&obj_res) ->            
-            ::rustfp::Result<const dom_obj &, std::string> {
+            ::rustfp::Result<dom_obj_cursor, parse_error> &&obj_res) ->            
+            ::rustfp::Result<dom_obj_cursor, parse_error> {
 
-            return std::move(obj_res).and_then([this](const dom_obj &obj) {
+            return std::move(obj_res).and_then([this](dom_obj_cursor cursor) {
                 // alter the behaviour here to not necessary to find the name
-                const auto it = obj.find(name);
+                const auto it = cursor.find(name);
 
-                return (it != obj.cend())
-                    ? parse_value(ser.get(), it->second)
-                        .map([&obj](::rustfp::Option<Ser> &) { return std::ref(obj); })
+                return (it != cursor.get_obj().cend())
+                    ? as_parse_result(parse_value(ser.get(), it->second))
+                        .map([&cursor](::rustfp::Option<Ser> &) { return cursor; })
+                        .map_err([this](parse_error err) { return std::move(err.prepend_key(name)); })
 
-                    : [this, &obj] {
+                    : [this, &cursor] {
                         ser.get() = ::rustfp::None;
-                        return ::rustfp::Ok(std::ref(obj));
+                        return ::rustfp::Ok(cursor);
                     }();
             });
         }
 
+        template <class Ser>
+        auto parse_nvp_action<::rustfp::Option<Ser>>::get_ser() const -> ::rustfp::Option<Ser> & {
+            return ser.get();
+        }
+
+        template <class Ser>
+        auto parse_nvp_action<::rustfp::Option<Ser>>::get_name() const -> const str_ref & {
+            return name;
+        }
+
         template <class Ser>
         serialize_nvp_action<Ser>::serialize_nvp_action(
             const Ser &ser,
-            const std::string &name,
+            const str_ref &name,
             const bool is_attr) :
 
             ser(ser),
@@ -713,12 +984,11 @@ namespace serz {
 
         template <class Ser>
         auto serialize_nvp_action<Ser>::operator()(dom_obj &obj) -> dom_obj & {
-            // object will always have repetition in the names
-            dom_val child_val(name);
+            dom_val child_val;
             child_val.set_attribute(is_attr);
 
             serialize_value(ser.get(), child_val);
-            obj.emplace(name, std::move(child_val));
+            obj.emplace(name.to_string(), std::move(child_val));
 
             return obj;
         }
@@ -726,7 +996,7 @@ namespace serz {
         template <class Ser>
         serialize_nvp_action<::rustfp::Option<Ser>>::serialize_nvp_action(
             const ::rustfp::Option<Ser> &ser,
-            const std::string &name,
+            const str_ref &name,
             const bool is_attr) :
 
             ser(ser),
@@ -752,10 +1022,11 @@ namespace serz {
 
         template <class Ser>
         auto done_obj_action<Ser>::operator()(
-            ::rustfp::Result<const dom_obj &, std::string> &&obj_res) ->
-            ::rustfp::Result<Ser &, std::string> {
+            ::rustfp::Result<dom_obj_cursor, parse_error> &&obj_res) ->
+            parse_result<Ser> {
 
-            return std::move(obj_res).map([this](const dom_obj &) { return std::ref(ser.get()); });
+            return parse_result<Ser>(
+                std::move(obj_res).map([this](const dom_obj_cursor &) { return std::ref(ser.get()); }));
         }
 
         template <class Num, class DomType>
@@ -778,7 +1049,7 @@ namespace serz {
 
         template <class DomType, class Num>
         auto parse_value_number_impl(Num &ser, const dom_val &val) ->
-            ::rustfp::Result<Num &, std::string> {
+            ::rustfp::Result<Num &, parse_error> {
 
             return val.get<DomType>()
                 // try the direct integer/float type first
@@ -803,48 +1074,169 @@ namespace serz {
                                 });
                         });
                 })
-                .ok_or_else([] {
-                    return fmt::format("Unable to parse into value of type '{}'",
-                        parse_type_name<Num>::get());
+                .ok_or_else([&val] {
+                    const auto expected = std::is_same<DomType, dom_int>::value
+                        ? dom_val_type::int_type
+                        : dom_val_type::flt_type;
+
+                    const auto actual = val.get_type();
+
+                    return parse_error(
+                        actual == expected ? parse_errc::out_of_range
+                            : actual == dom_val_type::str_type ? parse_errc::invalid_value
+                            : parse_errc::type_mismatch,
+                        expected,
+                        actual,
+                        &parse_type_name<Num>::get);
                 });
         }
 
         template <class Int>
         auto parse_value_int_impl(Int &ser, const dom_val &val) ->
-            ::rustfp::Result<Int &, std::string> {
+            ::rustfp::Result<Int &, parse_error> {
 
             return parse_value_number_impl<dom_int>(ser, val);
         }
 
         template <class Flt>
         auto parse_value_flt_impl(Flt &ser, const dom_val &val) ->
-            ::rustfp::Result<Flt &, std::string> {
+            ::rustfp::Result<Flt &, parse_error> {
 
             return parse_value_number_impl<dom_flt>(ser, val);
         }
 
         template <class Ser>
-        auto parse_value_enum_impl<Ser, false>::exec(Ser &, const dom_val &) ->
+        auto parse_emplace_back(std::vector<Ser> &sers, const dom_val &val) ->
+            ::rustfp::Result<::rustfp::unit_t, parse_error> {
+
+            sers.emplace_back();
+            auto res = as_parse_result(parse_value(sers.back(), val));
+
+            if (res.is_err()) {
+                sers.pop_back();
+                return ::rustfp::Err(res.get_err_unchecked());
+            }
+
+            return ::rustfp::Ok(::rustfp::Unit);
+        }
+
+        inline auto parse_emplace_back(std::vector<bool> &sers, const dom_val &val) ->
+            ::rustfp::Result<::rustfp::unit_t, parse_error> {
+
+            bool ser = false;
+
+            return parse_value(ser, val).map([&ser, &sers](const bool) {
+                sers.push_back(ser);
+                return ::rustfp::Unit;
+            });
+        }
+
+        template <class Ser>
+        auto parse_at(std::vector<Ser> &sers, const size_t index, const dom_val &val) ->
+            ::rustfp::Result<::rustfp::unit_t, parse_error> {
+
+            return as_parse_result(parse_value(sers[index], val))
+                .map([](Ser &) { return ::rustfp::Unit; });
+        }
+
+        inline auto parse_at(std::vector<bool> &sers, const size_t index, const dom_val &val) ->
+            ::rustfp::Result<::rustfp::unit_t, parse_error> {
+
+            bool ser = sers[index];
+
+            return parse_value(ser, val).map([&ser, &sers, index](const bool) {
+                sers[index] = ser;
+                return ::rustfp::Unit;
+            });
+        }
+
+        template <class Ser>
+        auto parse_reuse_elems(std::vector<Ser> &sers, const dom_arr &arr) ->
+            ::rustfp::Result<std::vector<Ser> &, parse_error> {
+
+            // only the elements beyond the previous size are constructed
+            sers.resize(arr.size());
+
+            // stops at the first element that fails
+            for (size_t index = 0; index < arr.size(); ++index) {
+                const auto res = parse_at(sers, index, arr[index]);
+
+                if (res.is_err()) {
+                    auto err = res.get_err_unchecked();
+                    return ::rustfp::Err(std::move(err.prepend_index(index)));
+                }
+            }
+
+            return ::rustfp::Ok(std::ref(sers));
+        }
+
+        template <class Ser>
+        auto parse_reuse_entries(std::unordered_map<std::string, Ser> &sers, const dom_obj &obj) ->
+            ::rustfp::Result<std::unordered_map<std::string, Ser> &, parse_error> {
+
+            // stops at the first member that fails
+            for (const auto &obj_val : obj) {
+                auto it = sers.find(obj_val.first);
+
+                if (it == sers.end()) {
+                    it = sers.emplace(
+                        std::piecewise_construct,
+                        std::forward_as_tuple(obj_val.first),
+                        std::forward_as_tuple()).first;
+                }
+
+                auto res = as_parse_result(parse_value(it->second, obj_val.second));
+
+                if (res.is_err()) {
+                    auto err = res.get_err_unchecked();
+                    return ::rustfp::Err(std::move(err.prepend_key(obj_val.first)));
+                }
+            }
+
+            // every key of the DOM object is now present,
+            // so any extra entry must be of a key that is not
+            if (sers.size() > obj.size()) {
+                for (auto it = sers.begin(); it != sers.end();) {
+                    if (obj.find(it->first) != obj.cend()) {
+                        ++it;
+                    } else {
+                        it = sers.erase(it);
+                    }
+                }
+            }
+
+            return ::rustfp::Ok(std::ref(sers));
+        }
+
+        template <class Ser>
+        auto parse_value_with_msg(Ser &ser, const dom_val &val) ->
             ::rustfp::Result<Ser &, std::string> {
 
+            return as_parse_result(parse_value(ser, val))
+                .map_err([](const parse_error &err) { return err.to_string(); });
+        }
+
+        template <class Ser>
+        auto parse_value_enum_impl<Ser, false>::exec(Ser &, const dom_val &) ->
+            ::rustfp::Result<Ser &, parse_error> {
+
             static_assert(sizeof(Ser) < 0,
                 "parse_value must be defined for every custom type");
 
-            return ::rustfp::Err(std::string());
+            return ::rustfp::Err(parse_error(std::string()));
         }
 
         template <class Enum>
         auto parse_value_enum_impl<Enum, true>::exec(Enum &ser, const dom_val &val) ->
-            ::rustfp::Result<Enum &, std::string> {
+            ::rustfp::Result<Enum &, parse_error> {
 
             return val.get<dom_int>()
                 .map([&ser](const dom_int itg) {
                     ser = static_cast<Enum>(itg);
                     return std::ref(ser);
                 }) 
-                .ok_or_else([] {
-                    return std::string(
-                        "Unable to get dom_int from dom_val to parse enum");
+                .ok_or_else([&val] {
+                    return parse_error(parse_errc::type_mismatch, dom_val_type::int_type, val.get_type());
                 });
         }
 
@@ -908,17 +1300,17 @@ namespace serz {
 
     template <class Ser>
     auto operator&(
-        ::rustfp::Result<const dom_obj &, std::string> &&obj_res,
+        ::rustfp::Result<dom_obj_cursor, parse_error> &&obj_res,
         details::parse_nvp_action<Ser> &&action) ->
-        ::rustfp::Result<const dom_obj &, std::string> {
+        ::rustfp::Result<dom_obj_cursor, parse_error> {
 
         return action(std::move(obj_res));
     }
 
     template <class Ser>
     auto operator&(
-        ::rustfp::Result<const dom_obj &, std::string> &&obj_res,
-        details::done_obj_action<Ser> &&action) -> ::rustfp::Result<Ser &, std::string> {
+        ::rustfp::Result<dom_obj_cursor, parse_error> &&obj_res,
+        details::done_obj_action<Ser> &&action) -> parse_result<Ser> {
 
         return action(std::move(obj_res));
     }
@@ -930,10 +1322,11 @@ namespace serz {
         return action(obj);
     }
 
-    inline auto as_obj(const dom_val &val) -> ::rustfp::Result<const dom_obj &, std::string> {
+    inline auto as_obj(const dom_val &val) -> ::rustfp::Result<dom_obj_cursor, parse_error> {
         return val.get<dom_obj>()
-            .ok_or_else([] {
-                return std::string("Unable to interpret DOM value as DOM object");
+            .map([](const dom_obj &obj) { return dom_obj_cursor(obj); })
+            .ok_or_else([&val] {
+                return parse_error(parse_errc::type_mismatch, dom_val_type::obj_type, val.get_type());
             });
     }
 
@@ -951,34 +1344,33 @@ namespace serz {
     }
 
     template <class Ser>
-    auto parse_nvp(Ser &ser, const std::string &name) -> details::parse_nvp_action<Ser> {
+    auto parse_nvp(Ser &ser, const str_ref &name) -> details::parse_nvp_action<Ser> {
         return details::parse_nvp_action<Ser>(ser, name);
     }
 
     template <class Ser>
-    auto parse_value(Ser &ser, const dom_val &val) -> ::rustfp::Result<Ser &, std::string> {
+    auto parse_value(Ser &ser, const dom_val &val) -> parse_result<Ser> {
         return details::parse_value_enum_impl<Ser>::exec(ser, val);
     }
 
-    inline auto parse_value(::rustfp::unit_t &ser, const dom_val &) -> ::rustfp::Result<::rustfp::unit_t &, std::string> {
+    inline auto parse_value(::rustfp::unit_t &ser, const dom_val &) -> parse_result<::rustfp::unit_t> {
         return ::rustfp::Ok(std::ref(ser));
     }
 
-    inline auto parse_value(bool &ser, const dom_val &val) -> ::rustfp::Result<bool &, std::string> {
+    inline auto parse_value(bool &ser, const dom_val &val) -> parse_result<bool> {
         return val.get<dom_bln>()
             .map([&ser](const dom_bln bln) {
                 ser = bln;
                 return std::ref(ser);
             })
-            .ok_or_else([] {
-                return std::string("Unable to get boolean or string from given "
-                    "DOM value for parsing of bool");
+            .ok_or_else([&val] {
+                return parse_error(parse_errc::type_mismatch, dom_val_type::bool_type, val.get_type());
             })
 
-            .or_else([&ser, &val](const std::string &err_msg) {
+            .or_else([&ser, &val](const parse_error &err) {
                 return val.get<dom_str>()
-                    .ok_or_else([&err_msg] { return err_msg; })
-                    .and_then([&ser](const dom_str &str) -> ::rustfp::Result<bool &, std::string> {
+                    .ok_or_else([&err] { return err; })
+                    .and_then([&ser](const dom_str &str) -> ::rustfp::Result<bool &, parse_error> {
                         if (str == "true") {
                             ser = true;
                             return ::rustfp::Ok(std::ref(ser));
@@ -987,79 +1379,79 @@ namespace serz {
                             return ::rustfp::Ok(std::ref(ser));
                         }
 
-                        return ::rustfp::Err(
-                            fmt::format("Unable to convert '{}' to bool"));
+                        return ::rustfp::Err(parse_error(
+                            parse_errc::invalid_value, dom_val_type::bool_type, dom_val_type::str_type));
                     });
             });
     }
 
     inline auto parse_value(int8_t &ser, const dom_val &val) ->
-        ::rustfp::Result<int8_t &, std::string> {
+        parse_result<int8_t> {
 
         return details::parse_value_int_impl(ser, val);
     }
 
     inline auto parse_value(int16_t &ser, const dom_val &val) ->
-        ::rustfp::Result<int16_t &, std::string> {
+        parse_result<int16_t> {
 
         return details::parse_value_int_impl(ser, val);
     }
 
     inline auto parse_value(int32_t &ser, const dom_val &val) ->
-        ::rustfp::Result<int32_t &, std::string> {
+        parse_result<int32_t> {
 
         return details::parse_value_int_impl(ser, val);
     }
 
     inline auto parse_value(int64_t &ser, const dom_val &val) ->
-        ::rustfp::Result<int64_t &, std::string> {
+        parse_result<int64_t> {
 
         return details::parse_value_int_impl(ser, val);
     }
 
     inline auto parse_value(uint8_t &ser, const dom_val &val) ->
-        ::rustfp::Result<uint8_t &, std::string> {
+        parse_result<uint8_t> {
 
         return details::parse_value_int_impl(ser, val);
     }
 
     inline auto parse_value(uint16_t &ser, const dom_val &val) ->
-        ::rustfp::Result<uint16_t &, std::string> {
+        parse_result<uint16_t> {
 
         return details::parse_value_int_impl(ser, val);
     }
 
     inline auto parse_value(uint32_t &ser, const dom_val &val) ->
-        ::rustfp::Result<uint32_t &, std::string> {
+        parse_result<uint32_t> {
 
         return details::parse_value_int_impl(ser, val);
     }
 
     inline auto parse_value(uint64_t &ser, const dom_val &val) ->
-        ::rustfp::Result<uint64_t &, std::string> {
+        parse_result<uint64_t> {
 
         return details::parse_value_int_impl(ser, val);
     }
 
     inline auto parse_value(float &ser, const dom_val &val) ->
-        ::rustfp::Result<float &, std::string> {
+        parse_result<float> {
 
         return details::parse_value_flt_impl(ser, val);
     }
 
     inline auto parse_value(double &ser, const dom_val &val) ->
-        ::rustfp::Result<double &, std::string> {
+        parse_result<double> {
 
         return details::parse_value_flt_impl(ser, val);
     }
 
     inline auto parse_value(std::string &ser, const dom_val &val) ->
-        ::rustfp::Result<std::string &, std::string> {
+        parse_result<std::string> {
 
         return val.get<dom_str>()
-            // attach the error message first
-            .ok_or_else([] {
-                return std::string("Unable to interpret the DOM value as string");
+            // attach the error first
+            .ok_or_else([&val] {
+                return parse_error(parse_errc::type_mismatch, dom_val_type::str_type, val.get_type());
             })
 
             // if it is dom_str, just simply assign the value over
@@ -1070,19 +1462,19 @@ namespace serz {
 
             // otherwise try DomNullStringObject / dom_null variant,
             // accepting it as an empty string
-            .or_else([&ser, &val](const std::string &err_msg) {
+            .or_else([&ser, &val](const parse_error &err) {
                 return val.is<dom_null_str_obj>() || val.is<dom_null>()
-                    ? [&ser]() -> ::rustfp::Result<std::string &, std::string> {
+                    ? [&ser]() -> ::rustfp::Result<std::string &, parse_error> {
                         ser = "";
                         return ::rustfp::Ok(std::ref(ser));
                     }()
 
-                    : ::rustfp::Err(err_msg);
+                    : ::rustfp::Err(err);
             });
     }
 
     inline auto parse_value(dom_val &ser, const dom_val &val) ->
-        ::rustfp::Result<dom_val &, std::string> {
+        parse_result<dom_val> {
 
         ser = val;
         return ::rustfp::Ok(std::ref(ser));
@@ -1090,116 +1482,157 @@ namespace serz {
 
     template <class Ser>
     auto parse_value(std::vector<Ser> &sers, const dom_val &val) ->
-        ::rustfp::Result<std::vector<Ser> &, std::string> {
+        parse_result<std::vector<Ser>> {
 
         return val.get<dom_arr>()
-            // attach the error message first
-            .ok_or_else([] {
-                return std::string("Unable to interpret the DOM value as array");
+            // attach the error first
+            .ok_or_else([&val] {
+                return parse_error(parse_errc::type_mismatch, dom_val_type::arr_type, val.get_type());
             })
 
             // try to process the value as dom_arr
-            .and_then([&sers](const dom_arr &arr) {
-                auto res = ::rustfp::Result<::rustfp::unit_t, std::string>(::rustfp::Ok(::rustfp::Unit));
+            .and_then([&sers](const dom_arr &arr) -> ::rustfp::Result<std::vector<Ser> &, parse_error> {
+                if (get_parse_mode() == parse_mode::reuse) {
+                    return details::parse_reuse_elems(sers, arr);
+                }
 
-                for (const auto &arr_val : arr) {
-                    res = std::move(res).and_then([&arr_val, &sers](auto) {
-                        Ser ser;
+                sers.reserve(sers.size() + arr.size());
 
-                        return parse_value(ser, arr_val)
-                            .map([&ser, &sers](const Ser &) {
-                                sers.push_back(std::move(ser));
-                                return ::rustfp::Unit;
-                            });
-                    });
+                // stops at the first element that fails
+                for (size_t index = 0; index < arr.size(); ++index) {
+                    const auto res = details::parse_emplace_back(sers, arr[index]);
+
+                    if (res.is_err()) {
+                        auto err = res.get_err_unchecked();
+                        return ::rustfp::Err(std::move(err.prepend_index(index)));
+                    }
                 }
 
-                return std::move(res).map([&sers](auto) { return std::ref(sers); });
+                return ::rustfp::Ok(std::ref(sers));
             })
 
             // otherwise try dom_null, accepting it as an empty vector
-            .or_else([&sers, &val](const std::string &err_msg) {
+            .or_else([&sers, &val](const parse_error &err) {
                 return val.is<dom_null>()
-                    ? [&sers]() -> ::rustfp::Result<std::vector<Ser> &, std::string> {
+                    ? [&sers]() -> ::rustfp::Result<std::vector<Ser> &, parse_error> {
                         sers.clear();
                         return ::rustfp::Ok(std::ref(sers));
                     }()
 
-                    : ::rustfp::Err(err_msg);
+                    : ::rustfp::Err(err);
             })
             
-            // otherwise simply accept as a single value vector
-            .or_else([&sers, &val](const std::string &) {
+            // otherwise simply accept as a single value vector,
+            // unless it is an array whose element failed, which keeps its own error
+            .or_else([&sers, &val](const parse_error &err) -> ::rustfp::Result<std::vector<Ser> &, parse_error> {
+                if (val.is<dom_arr>()) {
+                    return ::rustfp::Err(err);
+                }
+
+                if (get_parse_mode() == parse_mode::reuse) {
+                    sers.resize(1);
+
+                    return details::parse_at(sers, 0, val)
+                        .map([&sers](auto) { return std::ref(sers); });
+                }
+
                 sers.clear();
-                Ser ser;
 
-                return parse_value(ser, val)
-                    .map([&ser, &sers](const Ser &) {
-                        sers.push_back(std::move(ser));
-                        return std::ref(sers);
-                    });
+                return details::parse_emplace_back(sers, val)
+                    .map([&sers](auto) { return std::ref(sers); });
             });
     }
 
     template <class Ser>
     auto parse_value(std::unordered_map<std::string, Ser> &sers, const dom_val &val) ->
-        ::rustfp::Result<std::unordered_map<std::string, Ser> &, std::string> {
+        parse_result<std::unordered_map<std::string, Ser>> {
 
         return val.get<dom_obj>()
-            // attach the error message first
-            .ok_or_else([] {
-                return std::string("Unable to interpret the DOM value as object");
+            // attach the error first
+            .ok_or_else([&val] {
+                return parse_error(parse_errc::type_mismatch, dom_val_type::obj_type, val.get_type());
             })
 
             // try to process the vlaue as dom_obj
-            .and_then([&sers](const dom_obj &obj) {
-                auto res = ::rustfp::Result<::rustfp::unit_t, std::string>(::rustfp::Ok(::rustfp::Unit));
+            .and_then([&sers](const dom_obj &obj) -> ::rustfp::Result<std::unordered_map<std::string, Ser> &, parse_error> {
+                if (get_parse_mode() == parse_mode::reuse) {
+                    return details::parse_reuse_entries(sers, obj);
+                }
+
+                sers.reserve(sers.size() + obj.size());
 
+                // stops at the first member that fails
                 for (const auto &obj_val : obj) {
-                    res = std::move(res).and_then([&obj_val, &sers](auto) {
+                    const auto emplaced = sers.emplace(
+                        std::piecewise_construct,
+                        std::forward_as_tuple(obj_val.first),
+                        std::forward_as_tuple());
+
+                    auto res = ::rustfp::Result<::rustfp::unit_t, parse_error>(::rustfp::Ok(::rustfp::Unit));
+
+                    if (emplaced.second) {
+                        res = details::as_parse_result(parse_value(emplaced.first->second, obj_val.second))
+                            .map([](Ser &) { return ::rustfp::Unit; });
+                    } else {
+                        // an existing entry is kept as it is, but the member must still parse
                         Ser ser;
 
-                        return parse_value(ser, obj_val.second).map([&obj_val, &sers](Ser &ser) {
-                            sers.emplace(obj_val.first, std::move(ser));
-                            return ::rustfp::Unit;
-                        });
-                    });
+                        res = details::as_parse_result(parse_value(ser, obj_val.second))
+                            .map([](Ser &) { return ::rustfp::Unit; });
+                    }
+
+                    if (res.is_err()) {
+                        if (emplaced.second) {
+                            sers.erase(emplaced.first);
+                        }
+
+                        auto err = res.get_err_unchecked();
+                        return ::rustfp::Err(std::move(err.prepend_key(obj_val.first)));
+                    }
                 }
 
-                return std::move(res).map([&sers](auto) { return std::ref(sers); });
+                return ::rustfp::Ok(std::ref(sers));
             })
 
             // otherwise try DomNullStringObject / dom_null,
             // accepting it as an empty unordered_map
-            .or_else([&sers, &val](const std::string &err_msg) {
+            .or_else([&sers, &val](const parse_error &err) {
                 return val.is<dom_null_str_obj>() || val.is<dom_null>()
-                    ? [&sers]() -> ::rustfp::Result<std::unordered_map<std::string, Ser> &, std::string> {
+                    ? [&sers]() -> ::rustfp::Result<std::unordered_map<std::string, Ser> &, parse_error> {
                         sers.clear();
                         return ::rustfp::Ok(std::ref(sers));
                     }()
 
-                    : ::rustfp::Err(err_msg);
+                    : ::rustfp::Err(err);
             });
     }
 
     template <class Ser>
     auto parse_value(::rustfp::Option<Ser> &ser, const dom_val &val) ->
-        ::rustfp::Result<::rustfp::Option<Ser> &, std::string> {
+        parse_result<::rustfp::Option<Ser>> {
 
         // since parse_nvp_action would have already found the dom_val
         // Option value here will definitely have a valid value
         // unless of parsing error of Ser
 
+        // parses into the existing value if there is one to reuse
+        if (get_parse_mode() == parse_mode::reuse && ser.is_some()) {
+            return details::as_parse_result(parse_value(ser.get_mut_unchecked(), val))
+                .map([&ser](const Ser &) { return std::ref(ser); });
+        }
+
+        // otherwise the option is only replaced on success
         Ser ser_inner;
 
-        return parse_value(ser_inner, val).map([&ser, &ser_inner](const Ser &) {
-            ser = ::rustfp::Some(std::move(ser_inner));
-            return std::ref(ser);
-        });
+        return details::as_parse_result(parse_value(ser_inner, val))
+            .map([&ser, &ser_inner](const Ser &) {
+                ser = ::rustfp::Some(std::move(ser_inner));
+                return std::ref(ser);
+            });
     }
 
     template <class Ser>
-    auto serialize_nvp(const Ser &ser, const std::string &name, const bool is_attr) ->
+    auto serialize_nvp(const Ser &ser, const str_ref &name, const bool is_attr) ->
         details::serialize_nvp_action<Ser> {
 
         return details::serialize_nvp_action<Ser>(ser, name, is_attr);
@@ -1275,6 +1708,11 @@ namespace serz {
         return val;
     }
 
+    inline auto serialize_value(const str_ref &ser, dom_val &val) -> dom_val & {
+        val = ser.to_string();
+        return val;
+    }
+
     inline auto serialize_value(const dom_val &ser, dom_val &val) -> dom_val & {
         val = ser;
         return val;
@@ -1283,13 +1721,15 @@ namespace serz {
     template <class Ser>
     auto serialize_value(const std::vector<Ser> &sers, dom_val &val) -> dom_val & {
         dom_arr arr;
+        arr.reserve(sers.size());
 
         for (const auto &ser : sers) {
             dom_val child_val;
-            arr.push_back(serialize_value(ser, child_val));
+            serialize_value(ser, child_val);
+            arr.push_back(std::move(child_val));
         }
 
-        val = arr;
+        val = std::move(arr);
         return val;
     }
 
@@ -1298,9 +1738,10 @@ namespace serz {
         const std::unordered_map<std::string, Ser> &sers, dom_val &val) -> dom_val & {
 
         auto &obj = create_obj(val);
+        obj.reserve(obj.size() + sers.size());
 
         for (const auto &nameSrz : sers) {
-            dom_val child_val(nameSrz.first);
+            dom_val child_val;
             serialize_value(nameSrz.second, child_val);
             obj.emplace(nameSrz.first, std::move(child_val)); 
         }
@@ -6,4 +6,6 @@
 
 #pragma once
 
-#include "serz_json.h"
\ No newline at end of file
+#include "fields.h"
+#include "serz_json.h"
+#include "serz_jsonl.h"
\ No newline at end of file
@@ -7,26 +7,44 @@
 #pragma once
 
 #include "etor.h"
+#include "mapped_file.h"
+#include "sax.h"
 #include "serialization.h"
 
 #include "rustfp/result.h"
 #include "rustfp/unit.h"
 
 #include "rapidjson/document.h"
+#include "rapidjson/error/en.h"
+#include "rapidjson/istreamwrapper.h"
+#include "rapidjson/memorystream.h"
 #include "rapidjson/prettywriter.h"
-#include "rapidjson/stringbuffer.h"
+#include "rapidjson/reader.h"
+#include "rapidjson/writer.h"
 
 #ifndef FMT_HEADER_ONLY
 #define FMT_HEADER_ONLY
 #endif
 #include "fmt/format.h"
 
+#if defined(__unix__) || defined(__APPLE__)
+#define SERZ_HAS_UNISTD
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
 #include <fstream>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace serz {
     // declaration section
@@ -46,11 +64,72 @@ namespace serz {
     /** Alias to implementation JSON string. */
     using json_str = std::string;
 
+    /**
+     * Describes the failure of parsing JSON content, without holding
+     * more than a short excerpt of the content around the failure.
+     */
+    struct json_parse_error {
+        /**
+         * Reason of the failure.
+         */
+        rapidjson::ParseErrorCode code;
+
+        /**
+         * Position of the failure in bytes from the start of the content.
+         */
+        size_t offset;
+
+        /**
+         * Line number of the failure, starting from 1.
+         * 0 if the content is not available, e.g. for stream or in-situ input.
+         */
+        size_t line;
+
+        /**
+         * Column number of the failure in bytes, starting from 1.
+         * 0 if the content is not available, e.g. for stream or in-situ input.
+         */
+        size_t column;
+
+        /**
+         * Short excerpt of the content around the failure,
+         * with line breaks and tabs replaced by spaces.
+         */
+        std::string excerpt;
+
+        /**
+         * Formats the failure into a single line error message.
+         */
+        auto to_string() const -> std::string;
+    };
+
     /**
      * Parses the JSON content into DOM value.
      */
     auto parse_json(const std::string &content) -> ::rustfp::Result<dom_val, std::string>;
 
+    /**
+     * Same as parse_json, except that the failure is returned as a structured error.
+     */
+    auto parse_json_detailed(const std::string &content) -> ::rustfp::Result<dom_val, json_parse_error>;
+
+    /**
+     * Parses the JSON content in-situ into DOM value. The given buffer must be
+     * null terminated and is modified during parsing, which decodes every
+     * string in place and bypasses the intermediate rapidjson document.
+     */
+    auto parse_json_insitu(char content[]) -> ::rustfp::Result<dom_val, std::string>;
+
+    /**
+     * Parses the JSON content into DOM value lazily. The whole content is
+     * validated up front, but every object and array is only converted into
+     * its DOM value when its content is first accessed, one level at a time.
+     * The content is kept alive by the lazy values. A lazy value, along with
+     * its copies, may be read concurrently and is only parsed once, while
+     * modifying it through a non-const accessor takes the parsed value in place.
+     */
+    auto parse_json_lazy(std::string content) -> ::rustfp::Result<dom_val, std::string>;
+
     /**
      * Parses the JSON content from the given input file stream.
      */
@@ -58,6 +137,7 @@ namespace serz {
 
     /**
      * Parses the JSON content in the file path into DOM value.
+     * The file is memory-mapped where possible to avoid copying its content.
      */
     auto parse_json_from_file(const std::string &file_path) -> ::rustfp::Result<dom_val, std::string>;
 
@@ -74,6 +154,20 @@ namespace serz {
     template <class Ser>
     auto parse_from_json_content_and_ret(const std::string &content) -> ::rustfp::Result<Ser, std::string>;
 
+    /**
+     * Same as parse_from_json_content, except that the JSON content is parsed
+     * lazily, so that only the objects and arrays accessed by parse_value are converted.
+     */
+    template <class Ser>
+    auto parse_from_json_content_lazy(Ser &ser, std::string content) -> ::rustfp::Result<Ser &, std::string>;
+
+    /**
+     * Same as parse_from_json_content_lazy, except that it returns the serializable value.
+     * Serializable value must be default constructible.
+     */
+    template <class Ser>
+    auto parse_from_json_content_lazy_and_ret(std::string content) -> ::rustfp::Result<Ser, std::string>;
+
     /**
      * Parses the JSON content into the referenced serializable value
      * from the given input file stream.
@@ -101,49 +195,417 @@ namespace serz {
     template <class Ser>
     auto parse_from_json_file_and_ret(const std::string &file_path) -> ::rustfp::Result<Ser, std::string>;
 
+    /**
+     * Parses the JSON content directly into the referenced serializable value
+     * without building the intermediate DOM value. Values with parse_fields
+     * defined are filled straight from the parsing events, while other values
+     * fall back to parse_value on the DOM value of their own subtree.
+     */
+    template <class Ser>
+    auto parse_from_json_content_sax(Ser &ser, const std::string &content) -> ::rustfp::Result<Ser &, std::string>;
+
+    /**
+     * Same as parse_from_json_content_sax, except that it returns the serializable value.
+     * Serializable value must be default constructible.
+     */
+    template <class Ser>
+    auto parse_from_json_content_sax_and_ret(const std::string &content) -> ::rustfp::Result<Ser, std::string>;
+
+    /**
+     * Same as parse_from_json_content_sax, except that the JSON content is parsed
+     * in-situ. The given buffer must be null terminated and is modified during
+     * parsing. str_ref values borrow from the buffer, so the buffer must
+     * outlive the serializable value.
+     */
+    template <class Ser>
+    auto parse_from_json_insitu(Ser &ser, char content[]) -> ::rustfp::Result<Ser &, std::string>;
+
+    /**
+     * Same as parse_from_json_insitu, except that it returns the serializable value.
+     * Serializable value must be default constructible.
+     */
+    template <class Ser>
+    auto parse_from_json_insitu_and_ret(char content[]) -> ::rustfp::Result<Ser, std::string>;
+
+    /**
+     * Same as parse_from_json_content_sax, except that the JSON content
+     * is read incrementally from the given input stream.
+     */
+    template <class Ser>
+    auto parse_from_json_stream_sax(Ser &ser, std::istream &istr) -> ::rustfp::Result<Ser &, std::string>;
+
+    /**
+     * Same as parse_from_json_stream_sax, except that it returns the serializable value.
+     * Serializable value must be default constructible.
+     */
+    template <class Ser>
+    auto parse_from_json_stream_sax_and_ret(std::istream &istr) -> ::rustfp::Result<Ser, std::string>;
+
+    /**
+     * Same as parse_from_json_content_sax, except that the JSON content
+     * is read from the given file path, which is memory-mapped where possible.
+     */
+    template <class Ser>
+    auto parse_from_json_file_sax(Ser &ser, const std::string &file_path) -> ::rustfp::Result<Ser &, std::string>;
+
+    /**
+     * Same as parse_from_json_file_sax, except that it returns the serializable value.
+     * Serializable value must be default constructible.
+     */
+    template <class Ser>
+    auto parse_from_json_file_sax_and_ret(const std::string &file_path) -> ::rustfp::Result<Ser, std::string>;
+
+    /**
+     * Layout of the serialized JSON content.
+     */
+    enum class json_format {
+        /** No whitespace between tokens. */
+        compact,
+
+        /** Line breaks and indentation for every nested value. */
+        pretty,
+    };
+
+    /**
+     * Parses every element of a JSON array in the given content into a new
+     * serializable value, and passes each value into the given function in order.
+     * Only a single element is held in memory at any time. The array is either
+     * the top-level value, or is found by following the given key path of nested
+     * object members, in which case every other member is skipped.
+     * Returns the number of parsed elements. Serializable value must be default constructible.
+     */
+    template <class Ser, class Fn>
+    auto parse_from_json_array_content(
+        const std::string &content,
+        Fn &&fn,
+        const std::vector<std::string> &key_path = {}) -> ::rustfp::Result<size_t, std::string>;
+
+    /**
+     * Same as parse_from_json_array_content, except that the JSON content
+     * is read incrementally from the given input stream.
+     */
+    template <class Ser, class Fn>
+    auto parse_from_json_array_stream(
+        std::istream &istr,
+        Fn &&fn,
+        const std::vector<std::string> &key_path = {}) -> ::rustfp::Result<size_t, std::string>;
+
+    /**
+     * Same as parse_from_json_array_content, except that the JSON content
+     * is read from the given file path, which is memory-mapped where possible.
+     */
+    template <class Ser, class Fn>
+    auto parse_from_json_array_file(
+        const std::string &file_path,
+        Fn &&fn,
+        const std::vector<std::string> &key_path = {}) -> ::rustfp::Result<size_t, std::string>;
+
     /**
      * Serializes the DOM value into JSON content.
      */
-    auto serialize_json(const dom_val &val) -> std::string;
+    auto serialize_json(const dom_val &val, const json_format format = json_format::pretty) -> std::string;
 
     /**
      * Serializes the DOM value into JSON content and writes into the output stream.
+     * The content is written in chunks as it is generated.
      */
-    auto serialize_json_into_stream(const dom_val &val, std::ostream &ostr) -> ::rustfp::Result<::rustfp::unit_t, std::string>;
+    auto serialize_json_into_stream(
+        const dom_val &val,
+        std::ostream &ostr,
+        const json_format format = json_format::pretty) -> ::rustfp::Result<::rustfp::unit_t, std::string>;
 
     /**
      * Serializes the DOM value into JSON content and writes into the given file path.
      */
-    auto serialize_json_into_file(const dom_val &val, const std::string &file_path) -> ::rustfp::Result<::rustfp::unit_t, std::string>;
+    auto serialize_json_into_file(
+        const dom_val &val,
+        const std::string &file_path,
+        const json_format format = json_format::pretty) -> ::rustfp::Result<::rustfp::unit_t, std::string>;
+
+#ifdef SERZ_HAS_UNISTD
+    /**
+     * Serializes the DOM value into JSON content and writes into the given file descriptor.
+     * The content is written in chunks as it is generated.
+     */
+    auto serialize_json_into_fd(
+        const dom_val &val,
+        const int fd,
+        const json_format format = json_format::pretty) -> ::rustfp::Result<::rustfp::unit_t, std::string>;
+#endif
+
+    /**
+     * Serializes the DOM value into JSON content and writes into the given buffer,
+     * returning the number of characters written. The content is not null terminated,
+     * and it is an error for the content to exceed the capacity of the buffer.
+     */
+    auto serialize_json_into_buffer(
+        const dom_val &val,
+        char buf[],
+        const size_t capacity,
+        const json_format format = json_format::pretty) -> ::rustfp::Result<size_t, std::string>;
 
     /**
      * Serializes the given serializable value into JSON content.
      */
     template <class Ser>
-    auto serialize_into_json_content(const Ser &ser) -> std::string;
+    auto serialize_into_json_content(const Ser &ser, const json_format format = json_format::pretty) -> std::string;
 
     /**
      * Serializes the given serializable value into JSON content and writes into the output stream.
      */
     template <class Ser>
-    auto serialize_into_json_stream(const Ser &ser, std::ostream &ostr) -> ::rustfp::Result<const Ser &, std::string>;
+    auto serialize_into_json_stream(
+        const Ser &ser,
+        std::ostream &ostr,
+        const json_format format = json_format::pretty) -> ::rustfp::Result<const Ser &, std::string>;
 
     /**
      * Serializes the given serializable value into JSON content and writes into the given file path.
      */
     template <class Ser>
-    auto serialize_into_json_file(const Ser &ser, const std::string &file_path) -> ::rustfp::Result<const Ser &, std::string>;
+    auto serialize_into_json_file(
+        const Ser &ser,
+        const std::string &file_path,
+        const json_format format = json_format::pretty) -> ::rustfp::Result<const Ser &, std::string>;
 
     // implementation section
 
     namespace details {
+        /**
+         * Flags used for all JSON parsing.
+         */
+        constexpr unsigned json_parse_flags =
+            rapidjson::kParseCommentsFlag | rapidjson::kParseTrailingCommasFlag;
+
+        /**
+         * Adapts the rapidjson reader events into the SAX context.
+         */
+        class json_sax_handler {
+        public:
+            explicit json_sax_handler(sax_ctx &ctx);
+
+            auto Null() -> bool;
+            auto Bool(const bool bln) -> bool;
+            auto Int(const int itg) -> bool;
+            auto Uint(const unsigned itg) -> bool;
+            auto Int64(const int64_t itg) -> bool;
+            auto Uint64(const uint64_t itg) -> bool;
+            auto Double(const double flt) -> bool;
+            auto RawNumber(const char str[], const rapidjson::SizeType len, const bool copy) -> bool;
+            auto String(const char str[], const rapidjson::SizeType len, const bool copy) -> bool;
+            auto StartObject() -> bool;
+            auto Key(const char str[], const rapidjson::SizeType len, const bool copy) -> bool;
+            auto EndObject(const rapidjson::SizeType member_count) -> bool;
+            auto StartArray() -> bool;
+            auto EndArray(const rapidjson::SizeType elem_count) -> bool;
+
+        private:
+            std::reference_wrapper<sax_ctx> ctx;
+        };
+
+        inline json_sax_handler::json_sax_handler(sax_ctx &ctx) :
+            ctx(ctx) {
+
+        }
+
+        inline auto json_sax_handler::Null() -> bool {
+            return ctx.get().null();
+        }
+
+        inline auto json_sax_handler::Bool(const bool bln) -> bool {
+            return ctx.get().bln(bln);
+        }
+
+        inline auto json_sax_handler::Int(const int itg) -> bool {
+            return ctx.get().itg(static_cast<int64_t>(itg));
+        }
+
+        inline auto json_sax_handler::Uint(const unsigned itg) -> bool {
+            return ctx.get().itg(static_cast<int64_t>(itg));
+        }
+
+        inline auto json_sax_handler::Int64(const int64_t itg) -> bool {
+            return ctx.get().itg(itg);
+        }
+
+        inline auto json_sax_handler::Uint64(const uint64_t itg) -> bool {
+            // only uint64_t will suffer loss in precision
+            return ctx.get().itg(static_cast<int64_t>(itg));
+        }
+
+        inline auto json_sax_handler::Double(const double flt) -> bool {
+            return ctx.get().flt(flt);
+        }
+
+        inline auto json_sax_handler::RawNumber(const char [], const rapidjson::SizeType, const bool) -> bool {
+            // never emitted since numbers are not parsed as strings
+            return false;
+        }
+
+        inline auto json_sax_handler::String(const char str[], const rapidjson::SizeType len, const bool) -> bool {
+            return ctx.get().str(str, len);
+        }
+
+        inline auto json_sax_handler::StartObject() -> bool {
+            return ctx.get().start_obj();
+        }
+
+        inline auto json_sax_handler::Key(const char str[], const rapidjson::SizeType len, const bool) -> bool {
+            return ctx.get().key(str, len);
+        }
+
+        inline auto json_sax_handler::EndObject(const rapidjson::SizeType) -> bool {
+            return ctx.get().end_obj();
+        }
+
+        inline auto json_sax_handler::StartArray() -> bool {
+            return ctx.get().start_arr();
+        }
+
+        inline auto json_sax_handler::EndArray(const rapidjson::SizeType) -> bool {
+            return ctx.get().end_arr();
+        }
+
+        /**
+         * Maximum number of characters taken into the excerpt from each side of the failure.
+         */
+        constexpr size_t json_excerpt_radius = 32;
+
+        /**
+         * Describes the failure at the offset into the content, which is either
+         * bounded by end, or null terminated if end is null. Only scans the content
+         * up to the failure, and never copies more than the bounded excerpt.
+         */
+        inline auto make_json_parse_error(
+            const rapidjson::ParseErrorCode code,
+            const size_t offset,
+            const char *const begin,
+            const char *const end) -> json_parse_error {
+
+            json_parse_error err{code, offset, 0, 0, std::string()};
+
+            if (begin == nullptr) {
+                return err;
+            }
+
+            const char *const pos = begin + offset;
+            const char *line_begin = begin;
+            err.line = 1;
+
+            for (auto it = begin; it < pos; ++it) {
+                if (*it == '\n') {
+                    ++err.line;
+                    line_begin = it + 1;
+                }
+            }
+
+            err.column = static_cast<size_t>(pos - line_begin) + 1;
+
+            const char *excerpt_it = offset > json_excerpt_radius ? pos - json_excerpt_radius : begin;
+
+            for (size_t i = 0; i < json_excerpt_radius * 2; ++i, ++excerpt_it) {
+                if ((end != nullptr && excerpt_it >= end) || (end == nullptr && excerpt_it >= pos && *excerpt_it == '\0')) {
+                    break;
+                }
+
+                const auto c = *excerpt_it;
+                err.excerpt.push_back(c == '\n' || c == '\r' || c == '\t' ? ' ' : c);
+            }
+
+            return err;
+        }
+
+        inline auto json_stream_range(const rapidjson::StringStream &istr) -> std::pair<const char *, const char *> {
+            return std::make_pair(istr.head_, nullptr);
+        }
+
+        inline auto json_stream_range(const rapidjson::MemoryStream &istr) -> std::pair<const char *, const char *> {
+            return std::make_pair(istr.begin_, istr.end_);
+        }
+
+        // content of other streams, such as the wrapped input streams, is not retained,
+        // while in-situ content before the failure has already been decoded over
+        template <class InputStream>
+        auto json_stream_range(const InputStream &) -> std::pair<const char *, const char *> {
+            return std::make_pair(nullptr, nullptr);
+        }
+
+        template <unsigned Flags, class InputStream>
+        auto parse_json_sink_with(
+            std::unique_ptr<sax_sink> &&sink,
+            InputStream &istr,
+            rapidjson::Reader &reader,
+            sax_ctx &ctx) -> ::rustfp::Result<::rustfp::unit_t, std::string> {
+
+            ctx.reset();
+            ctx.push(std::move(sink));
+
+            return etor<>::mix([&istr, &reader, &ctx]() -> ::rustfp::Result<::rustfp::unit_t, std::string> {
+                json_sax_handler handler(ctx);
+                const rapidjson::ParseResult parse_res = reader.Parse<Flags>(istr, handler);
+
+                if (parse_res.Code() == rapidjson::kParseErrorTermination) {
+                    return ::rustfp::Err(ctx.get_error());
+                } else if (parse_res.Code() == rapidjson::kParseErrorDocumentEmpty) {
+                    // accept empty content, same as parsing null
+                    if (!ctx.null()) {
+                        return ::rustfp::Err(ctx.get_error());
+                    }
+                } else if (parse_res.IsError()) {
+                    const auto range = json_stream_range(istr);
+
+                    return ::rustfp::Err(make_json_parse_error(
+                        parse_res.Code(), parse_res.Offset(), range.first, range.second).to_string());
+                }
+
+                if (!ctx.is_done()) {
+                    return ::rustfp::Err(std::string("Incomplete JSON content for SAX parsing"));
+                }
+
+                return ::rustfp::Ok(::rustfp::Unit);
+            });
+        }
+
+        template <unsigned Flags, class Ser, class InputStream>
+        auto parse_json_sax_with(
+            Ser &ser,
+            InputStream &istr,
+            rapidjson::Reader &reader,
+            sax_ctx &ctx) -> ::rustfp::Result<Ser &, std::string> {
+
+            return parse_json_sink_with<Flags>(make_sax_sink(ser), istr, reader, ctx)
+                .map([&ser](::rustfp::unit_t) { return std::ref(ser); });
+        }
+
+        template <unsigned Flags = json_parse_flags, class Ser, class InputStream>
+        auto parse_json_sax_impl(Ser &ser, InputStream &istr) -> ::rustfp::Result<Ser &, std::string> {
+            sax_ctx ctx((Flags & rapidjson::kParseInsituFlag) != 0);
+            rapidjson::Reader reader;
+            return parse_json_sax_with<Flags>(ser, istr, reader, ctx);
+        }
+
+        template <class Ser, class Fn, class InputStream>
+        auto parse_json_array_impl(
+            InputStream &istr,
+            Fn &fn,
+            const std::vector<std::string> &key_path) -> ::rustfp::Result<size_t, std::string> {
+
+            size_t count = 0;
+            sax_ctx ctx;
+            rapidjson::Reader reader;
+
+            return parse_json_sink_with<json_parse_flags>(
+                make_sax_each_sink<Ser>(fn, count, key_path), istr, reader, ctx)
+                .map([&count](::rustfp::unit_t) { return count; });
+        }
+
         inline auto make_json_dom_val() -> dom_val {
             return dom_val();
         }
 
         template <class DomType>
         auto make_json_dom_val(DomType &&dom_type_v) -> dom_val {
-            return dom_val(dom_type_v);
+            return dom_val(std::forward<DomType>(dom_type_v));
         }
 
         inline auto parse_json_impl(const json_val &json_val_v) -> ::rustfp::Result<dom_val, std::string> {
@@ -152,13 +614,16 @@ namespace serz {
 
                 auto val = make_json_dom_val(dom_obj());
                 auto &obj = val.get_unchecked<dom_obj>();
+                obj.reserve(json_val_v.MemberCount());
 
                 for (const auto &json_pair : json_obj_v) {
-                    const auto childRes = parse_json_impl(json_pair.value);
+                    auto childRes = parse_json_impl(json_pair.value);
 
-                    childRes.match_ok([&json_pair, &obj](const dom_val &child_val_v) {
-                        obj.emplace(json_pair.name.GetString(), child_val_v);
-                    });
+                    if (childRes.is_ok()) {
+                        obj.emplace(
+                            dom_str(json_pair.name.GetString(), json_pair.name.GetStringLength()),
+                            std::move(childRes).unwrap_unchecked());
+                    }
                 }
 
                 return ::rustfp::Ok(std::move(val));
@@ -167,20 +632,20 @@ namespace serz {
 
                 auto val = make_json_dom_val(dom_arr());
                 auto &arr = val.get_unchecked<dom_arr>();
+                arr.reserve(jsonArr.Size());
 
                 for (const auto &jsonElem : jsonArr) {
-                    const auto childRes = parse_json_impl(jsonElem);
+                    auto childRes = parse_json_impl(jsonElem);
 
-                    childRes.match_ok([&arr](const dom_val &child_val_v) {
-                        arr.push_back(child_val_v);
-                    });
+                    if (childRes.is_ok()) {
+                        arr.push_back(std::move(childRes).unwrap_unchecked());
+                    }
                 }
 
                 return ::rustfp::Ok(std::move(val));
             } else if (json_val_v.IsString()) {
-                auto val = make_json_dom_val(dom_str());
-                val = std::string(json_val_v.GetString());
-                return ::rustfp::Ok(std::move(val));
+                return ::rustfp::Ok(make_json_dom_val(
+                    dom_str(json_val_v.GetString(), json_val_v.GetStringLength())));
             } else if (json_val_v.IsBool()) {
                 auto val = make_json_dom_val(dom_bln());
                 val = json_val_v.GetBool();
@@ -209,73 +674,465 @@ namespace serz {
             }
         }
 
-        inline void serialize_json_impl(const dom_val &val, json_val &json_val_v, json_doc &doc) {
-            if (val.is<dom_obj>()) {
-                const auto &obj = val.get_unchecked<dom_obj>();
-                auto json_obj_v = json_val_v.SetObject().GetObject();
+        /**
+         * Output stream that collects the written characters into a string.
+         */
+        class string_write_stream {
+        public:
+            using Ch = char;
+
+            explicit string_write_stream(std::string &str) :
+                str(str) {
+
+            }
+
+            void Put(const char c) {
+                str.push_back(c);
+            }
+
+            void Flush() {
+
+            }
+
+        private:
+            std::string &str;
+        };
+
+        /**
+         * Output stream that writes into a fixed capacity buffer
+         * and records any attempt to write past its capacity.
+         */
+        class buffer_write_stream {
+        public:
+            using Ch = char;
+
+            buffer_write_stream(char buf[], const size_t capacity) :
+                buf(buf),
+                capacity(capacity),
+                pos(0),
+                overflow(false) {
+
+            }
+
+            void Put(const char c) {
+                if (pos < capacity) {
+                    buf[pos++] = c;
+                } else {
+                    overflow = true;
+                }
+            }
+
+            void Flush() {
+
+            }
+
+            auto size() const -> size_t {
+                return pos;
+            }
+
+            auto is_overflow() const -> bool {
+                return overflow;
+            }
+
+        private:
+            char *buf;
+            size_t capacity;
+            size_t pos;
+            bool overflow;
+        };
+
+        /**
+         * Output stream that accumulates characters into a fixed chunk,
+         * and hands each filled chunk to the flush function.
+         * The flush function returns false to indicate a write failure,
+         * after which the remaining characters are discarded.
+         */
+        template <class FlushFn>
+        class chunk_write_stream {
+        public:
+            using Ch = char;
+
+            explicit chunk_write_stream(FlushFn flush_fn) :
+                flush_fn(std::move(flush_fn)),
+                pos(0),
+                failed(false) {
+
+            }
+
+            void Put(const char c) {
+                if (pos == chunk.size()) {
+                    Flush();
+                }
+
+                chunk[pos++] = c;
+            }
+
+            void Flush() {
+                if (pos > 0 && !failed) {
+                    failed = !flush_fn(chunk.data(), pos);
+                }
+
+                pos = 0;
+            }
+
+            auto is_failed() const -> bool {
+                return failed;
+            }
+
+        private:
+            FlushFn flush_fn;
+            std::array<char, 16384> chunk;
+            size_t pos;
+            bool failed;
+        };
+
+        template <class FlushFn>
+        auto make_chunk_write_stream(FlushFn &&flush_fn) -> chunk_write_stream<std::decay_t<FlushFn>> {
+            return chunk_write_stream<std::decay_t<FlushFn>>(std::forward<FlushFn>(flush_fn));
+        }
+
+        /**
+         * Emits the JSON tokens of each visited DOM value into the writer.
+         */
+        template <class Writer>
+        class json_write_visitor {
+        public:
+            explicit json_write_visitor(Writer &writer) :
+                writer(writer) {
+
+            }
+
+            auto operator()(const dom_obj &obj) const -> bool {
+                if (!writer.get().StartObject()) {
+                    return false;
+                }
+
+                for (const auto &key_value : obj) {
+                    const auto &key = key_value.first;
 
-                for (const auto &keyValue : obj) {
-                    json_val jsonStrVal;
-                    jsonStrVal.SetString(keyValue.first.c_str(), doc.GetAllocator());
+                    if (!writer.get().Key(key.data(), static_cast<rapidjson::SizeType>(key.size()))
+                        || !key_value.second.visit(*this)) {
 
-                    json_val child_val_v;
-                    serialize_json_impl(keyValue.second, child_val_v, doc);
-                    json_obj_v.AddMember(jsonStrVal, child_val_v, doc.GetAllocator());
+                        return false;
+                    }
+                }
+
+                return writer.get().EndObject(static_cast<rapidjson::SizeType>(obj.size()));
+            }
+
+            auto operator()(const dom_arr &arr) const -> bool {
+                if (!writer.get().StartArray()) {
+                    return false;
                 }
-            } else if (val.is<dom_arr>()) {
-                const auto &arr = val.get_unchecked<dom_arr>();
-                auto jsonArr = json_val_v.SetArray().GetArray();
 
                 for (const auto &elem : arr) {
-                    json_val child_val_v;
-                    serialize_json_impl(elem, child_val_v, doc);
-                    jsonArr.PushBack(child_val_v, doc.GetAllocator());
+                    if (!elem.visit(*this)) {
+                        return false;
+                    }
+                }
+
+                return writer.get().EndArray(static_cast<rapidjson::SizeType>(arr.size()));
+            }
+
+            auto operator()(const dom_bln bln) const -> bool {
+                return writer.get().Bool(bln);
+            }
+
+            auto operator()(const dom_int itg) const -> bool {
+                return writer.get().Int64(itg);
+            }
+
+            auto operator()(const dom_flt flt) const -> bool {
+                return writer.get().Double(flt);
+            }
+
+            auto operator()(const dom_str &str) const -> bool {
+                return writer.get().String(str.data(), static_cast<rapidjson::SizeType>(str.size()));
+            }
+
+            auto operator()(const dom_null) const -> bool {
+                return writer.get().Null();
+            }
+
+            auto operator()(const dom_null_str_obj) const -> bool {
+                return writer.get().Null();
+            }
+
+        private:
+            std::reference_wrapper<Writer> writer;
+        };
+
+        template <class Writer>
+        auto write_json_impl(const dom_val &val, Writer &writer) -> bool {
+            return val.visit(json_write_visitor<Writer>(writer));
+        }
+
+        /**
+         * Walks the DOM value and emits the JSON tokens directly into the output stream.
+         */
+        template <class OutputStream>
+        auto write_json(const dom_val &val, OutputStream &ostr, const json_format format) -> ::rustfp::Result<::rustfp::unit_t, std::string> {
+            bool is_written = false;
+
+            if (format == json_format::pretty) {
+                rapidjson::PrettyWriter<OutputStream> writer(ostr);
+                is_written = write_json_impl(val, writer);
+            } else {
+                rapidjson::Writer<OutputStream> writer(ostr);
+                is_written = write_json_impl(val, writer);
+            }
+
+            ostr.Flush();
+
+            if (!is_written) {
+                return ::rustfp::Err(std::string("Unable to write non-finite floating point value as JSON"));
+            }
+
+            return ::rustfp::Ok(::rustfp::Unit);
+        }
+    }
+
+    namespace details {
+        inline auto skip_json_ws(const char *it, const char *const end) -> const char * {
+            while (it < end) {
+                if (*it == ' ' || *it == '\t' || *it == '\n' || *it == '\r') {
+                    ++it;
+                } else if (*it == '/' && it + 1 < end && it[1] == '*') {
+                    it += 2;
+
+                    while (it + 1 < end && !(it[0] == '*' && it[1] == '/')) {
+                        ++it;
+                    }
+
+                    it = std::min(it + 2, end);
+                } else if (*it == '/' && it + 1 < end && it[1] == '/') {
+                    while (it < end && *it != '\n') {
+                        ++it;
+                    }
+                } else {
+                    break;
+                }
+            }
+
+            return it;
+        }
+
+        inline auto skip_json_str(const char *it, const char *const end) -> const char * {
+            // skips the opening quote
+            ++it;
+
+            while (it < end) {
+                if (*it == '\\') {
+                    it += 2;
+                } else if (*it == '"') {
+                    return it + 1;
+                } else {
+                    ++it;
                 }
-            } else if (val.is<dom_bln>()) {
-                json_val_v.SetBool(val.get_unchecked<dom_bln>());
-            } else if (val.is<dom_int>()) {
-                json_val_v.SetInt64(val.get_unchecked<dom_int>());
-            } else if (val.is<dom_flt>()) {
-                json_val_v.SetDouble(val.get_unchecked<dom_flt>());
-            } else if (val.is<dom_str>()) {
-                const auto &str = val.get_unchecked<dom_str>();
-                json_val_v.SetString(str.c_str(), doc.GetAllocator());
             }
+
+            return end;
+        }
+
+        // finds the end of a valid value without converting any of it
+        inline auto skip_json_val(const char *it, const char *const end) -> const char * {
+            if (*it == '"') {
+                return skip_json_str(it, end);
+            } else if (*it == '{' || *it == '[') {
+                size_t depth = 0;
+
+                while (it < end) {
+                    if (*it == '"') {
+                        it = skip_json_str(it, end);
+                    } else if (*it == '{' || *it == '[') {
+                        ++depth;
+                        ++it;
+                    } else if (*it == '}' || *it == ']') {
+                        ++it;
+
+                        if (--depth == 0) {
+                            return it;
+                        }
+                    } else if (*it == '/') {
+                        it = skip_json_ws(it, end);
+                    } else {
+                        ++it;
+                    }
+                }
+
+                return end;
+            } else {
+                while (it < end && std::strchr(",]}/ \t\n\r", *it) == nullptr) {
+                    ++it;
+                }
+
+                return it;
+            }
+        }
+
+        inline auto materialize_json_lazy(const dom_lazy &lazy) -> dom_val;
+
+        // keeps objects and arrays lazy, and converts scalars right away
+        inline auto make_json_lazy_val(
+            const std::shared_ptr<const std::string> &src,
+            const char *const begin,
+            const char *const end,
+            rapidjson::Reader &reader,
+            sax_ctx &ctx) -> dom_val {
+
+            if (*begin == '{' || *begin == '[') {
+                return dom_val(dom_lazy{
+                    src,
+                    static_cast<size_t>(begin - src->data()),
+                    static_cast<size_t>(end - begin),
+                    *begin == '{',
+                    &materialize_json_lazy});
+            }
+
+            // cannot fail, since the whole source is validated up front
+            dom_val val;
+            rapidjson::MemoryStream istr(begin, static_cast<size_t>(end - begin));
+            parse_json_sax_with<json_parse_flags>(val, istr, reader, ctx);
+            return val;
+        }
+
+        inline auto materialize_json_lazy(const dom_lazy &lazy) -> dom_val {
+            const char *it = lazy.src->data() + lazy.offset + 1;
+            const char *const end = lazy.src->data() + lazy.offset + lazy.len;
+            const char close = lazy.is_obj ? '}' : ']';
+
+            sax_ctx ctx;
+            rapidjson::Reader reader;
+            dom_obj obj;
+            dom_arr arr;
+
+            while ((it = skip_json_ws(it, end)) < end && *it != close) {
+                if (lazy.is_obj) {
+                    const auto key_end = skip_json_str(it, end);
+
+                    std::string key;
+                    rapidjson::MemoryStream key_istr(it, static_cast<size_t>(key_end - it));
+                    parse_json_sax_with<json_parse_flags>(key, key_istr, reader, ctx);
+
+                    // skips the colon
+                    it = skip_json_ws(skip_json_ws(key_end, end) + 1, end);
+
+                    const auto val_end = skip_json_val(it, end);
+                    obj.emplace(std::move(key), make_json_lazy_val(lazy.src, it, val_end, reader, ctx));
+                    it = val_end;
+                } else {
+                    const auto val_end = skip_json_val(it, end);
+                    arr.push_back(make_json_lazy_val(lazy.src, it, val_end, reader, ctx));
+                    it = val_end;
+                }
+
+                it = skip_json_ws(it, end);
+
+                if (it < end && *it == ',') {
+                    ++it;
+                }
+            }
+
+            return lazy.is_obj ? dom_val(std::move(obj)) : dom_val(std::move(arr));
+        }
+
+        inline auto parse_json_buffer(const char content[], const size_t len) -> ::rustfp::Result<dom_val, std::string> {
+            return etor<>::mix([content, len] {
+                rapidjson::Document doc;
+                doc.Parse<json_parse_flags>(content, len);
+
+                // accept empty content
+                return !doc.HasParseError() || len == 0
+                    ? parse_json_impl(doc)
+                    : ::rustfp::Err(make_json_parse_error(
+                        doc.GetParseError(), doc.GetErrorOffset(), content, content + len).to_string());
+            });
         }
     }
 
+    inline auto json_parse_error::to_string() const -> std::string {
+        if (line == 0) {
+            return fmt::format("Error in parsing JSON content at offset {}: {}",
+                offset, rapidjson::GetParseError_En(code));
+        }
+
+        return fmt::format("Error in parsing JSON content at line {}, column {} (offset {}): {} Near: '{}'",
+            line, column, offset, rapidjson::GetParseError_En(code), excerpt);
+    }
+
     inline auto parse_json(const std::string &content) -> ::rustfp::Result<dom_val, std::string> {
-        return etor<>::mix([&content] {
-            rapidjson::Document doc;
-            doc.Parse<rapidjson::kParseCommentsFlag | rapidjson::kParseTrailingCommasFlag>(content.c_str());
-
-            // accept empty content
-            return !doc.HasParseError() || content.empty()
-                ? details::parse_json_impl(doc)
-                : ::rustfp::Err(fmt::format("Error in parsing JSON content: {}", content));
-        });
+        return details::parse_json_buffer(content.data(), content.size());
     }
-    
-    inline auto parse_json_from_stream(std::istream &istr) -> ::rustfp::Result<dom_val, std::string> {
-        std::stringstream fileStrStream;
-        fileStrStream << istr.rdbuf();
-        return parse_json(fileStrStream.str());
+
+    inline auto parse_json_detailed(const std::string &content) -> ::rustfp::Result<dom_val, json_parse_error> {
+        rapidjson::Document doc;
+        doc.Parse<details::json_parse_flags>(content.data(), content.size());
+
+        // accept empty content
+        if (doc.HasParseError() && !content.empty()) {
+            return ::rustfp::Err(details::make_json_parse_error(
+                doc.GetParseError(), doc.GetErrorOffset(), content.data(), content.data() + content.size()));
+        }
+
+        // converting a successfully parsed document cannot fail
+        return ::rustfp::Ok(details::parse_json_impl(doc).unwrap_unchecked());
     }
+    
+    inline auto parse_json_lazy(std::string content) -> ::rustfp::Result<dom_val, std::string> {
+        const auto src = std::make_shared<const std::string>(std::move(content));
+
+        rapidjson::Reader reader;
+        rapidjson::BaseReaderHandler<> handler;
+        rapidjson::StringStream istr(src->c_str());
+        const rapidjson::ParseResult parse_res = reader.Parse<details::json_parse_flags>(istr, handler);
+
+        // accept empty content
+        if (parse_res.IsError() && !src->empty()) {
+            return ::rustfp::Err(details::make_json_parse_error(
+                parse_res.Code(), parse_res.Offset(), src->data(), src->data() + src->size()).to_string());
+        }
 
-    inline auto parse_json_from_file(const std::string &file_path) -> ::rustfp::Result<dom_val, std::string> {
-        std::ifstream file_stream(file_path);
+        const char *const end = src->data() + src->size();
+        const char *const begin = details::skip_json_ws(src->data(), end);
 
-        if (!file_stream){
-            return ::rustfp::Err(fmt::format("Cannot open file at '{}' for JSON parsing", file_path));
+        if (begin == end) {
+            return ::rustfp::Ok(dom_val());
         }
 
-        return parse_json_from_stream(file_stream);
+        sax_ctx ctx;
+        return ::rustfp::Ok(details::make_json_lazy_val(src, begin, details::skip_json_val(begin, end), reader, ctx));
+    }
+
+    inline auto parse_json_insitu(char content[]) -> ::rustfp::Result<dom_val, std::string> {
+        dom_val val;
+        rapidjson::InsituStringStream istr(content);
+
+        return details::parse_json_sax_impl<details::json_parse_flags | rapidjson::kParseInsituFlag>(val, istr)
+            .map([](dom_val &val) { return std::move(val); });
+    }
+
+    inline auto parse_json_from_stream(std::istream &istr) -> ::rustfp::Result<dom_val, std::string> {
+        const std::string content(
+            (std::istreambuf_iterator<char>(istr)),
+            std::istreambuf_iterator<char>());
+
+        return parse_json(content);
+    }
+
+    inline auto parse_json_from_file(const std::string &file_path) -> ::rustfp::Result<dom_val, std::string> {
+        return mapped_file::open(file_path)
+            .map_err([&file_path](const std::string &) {
+                return fmt::format("Cannot open file at '{}' for JSON parsing", file_path);
+            })
+            .and_then([](const mapped_file &file) {
+                return details::parse_json_buffer(file.data(), file.size());
+            });
     }
 
     template <class Ser>
     auto parse_from_json_content(Ser &ser, const std::string &content) -> ::rustfp::Result<Ser &, std::string> {
         return parse_json(content)
-            .and_then([&ser](const dom_val &val) { return parse_value(ser, val); });
+            .and_then([&ser](const dom_val &val) { return details::parse_value_with_msg(ser, val); });
     }
 
     template <class Ser>
@@ -286,10 +1143,24 @@ namespace serz {
             .map([](Ser &ser) { return std::move(ser); });
     }
 
+    template <class Ser>
+    auto parse_from_json_content_lazy(Ser &ser, std::string content) -> ::rustfp::Result<Ser &, std::string> {
+        return parse_json_lazy(std::move(content))
+            .and_then([&ser](const dom_val &val) { return details::parse_value_with_msg(ser, val); });
+    }
+
+    template <class Ser>
+    auto parse_from_json_content_lazy_and_ret(std::string content) -> ::rustfp::Result<Ser, std::string> {
+        Ser ser;
+
+        return parse_from_json_content_lazy(ser, std::move(content))
+            .map([](Ser &ser) { return std::move(ser); });
+    }
+
     template <class Ser>
     auto parse_from_json_stream(Ser &ser, std::istream &istr) -> ::rustfp::Result<Ser &, std::string> {
         return parse_json_from_stream(istr)
-            .and_then([&ser](const dom_val &val) { return parse_value(ser, val); });
+            .and_then([&ser](const dom_val &val) { return details::parse_value_with_msg(ser, val); });
     }
 
     template <class Ser>
@@ -303,7 +1174,7 @@ namespace serz {
     template <class Ser>
     auto parse_from_json_file(Ser &ser, const std::string &file_path) -> ::rustfp::Result<Ser &, std::string> {
         return parse_json_from_file(file_path)
-            .and_then([&ser](const dom_val &val) { return parse_value(ser, val); });
+            .and_then([&ser](const dom_val &val) { return details::parse_value_with_msg(ser, val); });
     }
 
     template <class Ser>
@@ -314,55 +1185,228 @@ namespace serz {
             .map([](Ser &ser) { return std::move(ser); });
     }
 
-    inline auto serialize_json(const dom_val &val) -> std::string {
-        rapidjson::Document doc;
-        details::serialize_json_impl(val, doc, doc);
+    template <class Ser>
+    auto parse_from_json_content_sax(Ser &ser, const std::string &content) -> ::rustfp::Result<Ser &, std::string> {
+        rapidjson::StringStream istr(content.c_str());
+        return details::parse_json_sax_impl(ser, istr);
+    }
 
-        rapidjson::StringBuffer buf;
-        rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buf);
-        doc.Accept(writer);
+    template <class Ser>
+    auto parse_from_json_content_sax_and_ret(const std::string &content) -> ::rustfp::Result<Ser, std::string> {
+        Ser ser;
 
-        return std::string(buf.GetString(), buf.GetSize());
+        return parse_from_json_content_sax(ser, content)
+            .map([](Ser &ser) { return std::move(ser); });
+    }
+
+    template <class Ser>
+    auto parse_from_json_insitu(Ser &ser, char content[]) -> ::rustfp::Result<Ser &, std::string> {
+        rapidjson::InsituStringStream istr(content);
+        return details::parse_json_sax_impl<details::json_parse_flags | rapidjson::kParseInsituFlag>(ser, istr);
+    }
+
+    template <class Ser>
+    auto parse_from_json_insitu_and_ret(char content[]) -> ::rustfp::Result<Ser, std::string> {
+        Ser ser;
+
+        return parse_from_json_insitu(ser, content)
+            .map([](Ser &ser) { return std::move(ser); });
+    }
+
+    template <class Ser>
+    auto parse_from_json_stream_sax(Ser &ser, std::istream &istr) -> ::rustfp::Result<Ser &, std::string> {
+        rapidjson::IStreamWrapper istr_wrapper(istr);
+        return details::parse_json_sax_impl(ser, istr_wrapper);
     }
 
-    inline auto serialize_json_into_stream(const dom_val &val, std::ostream &ostr) -> ::rustfp::Result<::rustfp::unit_t, std::string> {
-        const auto serializedStr = serialize_json(val);
-        ostr << serializedStr;
-        return ::rustfp::Ok(::rustfp::Unit);
+    template <class Ser>
+    auto parse_from_json_stream_sax_and_ret(std::istream &istr) -> ::rustfp::Result<Ser, std::string> {
+        Ser ser;
+
+        return parse_from_json_stream_sax(ser, istr)
+            .map([](Ser &ser) { return std::move(ser); });
     }
 
-    inline auto serialize_json_into_file(const dom_val &val, const std::string &file_path) -> ::rustfp::Result<::rustfp::unit_t, std::string> {
-        std::ofstream file_stream(file_path);
+    template <class Ser>
+    auto parse_from_json_file_sax(Ser &ser, const std::string &file_path) -> ::rustfp::Result<Ser &, std::string> {
+        return mapped_file::open(file_path)
+            .map_err([&file_path](const std::string &) {
+                return fmt::format("Cannot open file at '{}' for JSON parsing", file_path);
+            })
+            .and_then([&ser](const mapped_file &file) {
+                rapidjson::MemoryStream istr(file.data(), file.size());
+                return details::parse_json_sax_impl(ser, istr);
+            });
+    }
+
+    template <class Ser>
+    auto parse_from_json_file_sax_and_ret(const std::string &file_path) -> ::rustfp::Result<Ser, std::string> {
+        Ser ser;
+
+        return parse_from_json_file_sax(ser, file_path)
+            .map([](Ser &ser) { return std::move(ser); });
+    }
+
+    template <class Ser, class Fn>
+    auto parse_from_json_array_content(
+        const std::string &content,
+        Fn &&fn,
+        const std::vector<std::string> &key_path) -> ::rustfp::Result<size_t, std::string> {
+
+        rapidjson::StringStream istr(content.c_str());
+        return details::parse_json_array_impl<Ser>(istr, fn, key_path);
+    }
+
+    template <class Ser, class Fn>
+    auto parse_from_json_array_stream(
+        std::istream &istr,
+        Fn &&fn,
+        const std::vector<std::string> &key_path) -> ::rustfp::Result<size_t, std::string> {
+
+        rapidjson::IStreamWrapper istr_wrapper(istr);
+        return details::parse_json_array_impl<Ser>(istr_wrapper, fn, key_path);
+    }
+
+    template <class Ser, class Fn>
+    auto parse_from_json_array_file(
+        const std::string &file_path,
+        Fn &&fn,
+        const std::vector<std::string> &key_path) -> ::rustfp::Result<size_t, std::string> {
+
+        return mapped_file::open(file_path)
+            .map_err([&file_path](const std::string &) {
+                return fmt::format("Cannot open file at '{}' for JSON parsing", file_path);
+            })
+            .and_then([&fn, &key_path](const mapped_file &file) {
+                rapidjson::MemoryStream istr(file.data(), file.size());
+                return details::parse_json_array_impl<Ser>(istr, fn, key_path);
+            });
+    }
+
+    inline auto serialize_json(const dom_val &val, const json_format format) -> std::string {
+        std::string content;
+        details::string_write_stream ostr(content);
+        details::write_json(val, ostr, format);
+        return content;
+    }
+
+    inline auto serialize_json_into_stream(
+        const dom_val &val,
+        std::ostream &ostr,
+        const json_format format) -> ::rustfp::Result<::rustfp::unit_t, std::string> {
+
+        auto chunk_ostr = details::make_chunk_write_stream([&ostr](const char chunk[], const size_t len) {
+            return static_cast<bool>(ostr.write(chunk, static_cast<std::streamsize>(len)));
+        });
+
+        return details::write_json(val, chunk_ostr, format)
+            .and_then([&chunk_ostr](::rustfp::unit_t) -> ::rustfp::Result<::rustfp::unit_t, std::string> {
+                if (chunk_ostr.is_failed()) {
+                    return ::rustfp::Err(std::string("Unable to write JSON content into output stream"));
+                }
+
+                return ::rustfp::Ok(::rustfp::Unit);
+            });
+    }
+
+    inline auto serialize_json_into_file(
+        const dom_val &val,
+        const std::string &file_path,
+        const json_format format) -> ::rustfp::Result<::rustfp::unit_t, std::string> {
+
+        std::ofstream file_stream(file_path, std::ios::binary);
 
         if (!file_stream) {
             return ::rustfp::Err(fmt::format("Cannot open file at '{}' for JSON serialization", file_path));
         }
 
-        return serialize_json_into_stream(val, file_stream);
+        return serialize_json_into_stream(val, file_stream, format);
+    }
+
+#ifdef SERZ_HAS_UNISTD
+    inline auto serialize_json_into_fd(
+        const dom_val &val,
+        const int fd,
+        const json_format format) -> ::rustfp::Result<::rustfp::unit_t, std::string> {
+
+        auto chunk_ostr = details::make_chunk_write_stream([fd](const char chunk[], size_t len) {
+            while (len > 0) {
+                const auto written = ::write(fd, chunk, len);
+
+                if (written < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+
+                    return false;
+                }
+
+                chunk += written;
+                len -= static_cast<size_t>(written);
+            }
+
+            return true;
+        });
+
+        return details::write_json(val, chunk_ostr, format)
+            .and_then([fd, &chunk_ostr](::rustfp::unit_t) -> ::rustfp::Result<::rustfp::unit_t, std::string> {
+                if (chunk_ostr.is_failed()) {
+                    return ::rustfp::Err(fmt::format("Unable to write JSON content into file descriptor {}", fd));
+                }
+
+                return ::rustfp::Ok(::rustfp::Unit);
+            });
+    }
+#endif
+
+    inline auto serialize_json_into_buffer(
+        const dom_val &val,
+        char buf[],
+        const size_t capacity,
+        const json_format format) -> ::rustfp::Result<size_t, std::string> {
+
+        details::buffer_write_stream ostr(buf, capacity);
+
+        return details::write_json(val, ostr, format)
+            .and_then([capacity, &ostr](::rustfp::unit_t) -> ::rustfp::Result<size_t, std::string> {
+                if (ostr.is_overflow()) {
+                    return ::rustfp::Err(fmt::format("JSON content exceeds the buffer capacity of {}", capacity));
+                }
+
+                return ::rustfp::Ok(ostr.size());
+            });
     }
 
     template <class Ser>
-    auto serialize_into_json_content(const Ser &ser) -> std::string {
+    auto serialize_into_json_content(const Ser &ser, const json_format format) -> std::string {
         auto val = details::make_json_dom_val();
-        SerializeValue(ser, val);
-        return serialize_json(val);
+        serialize_value(ser, val);
+        return serialize_json(val, format);
     }
 
     template <class Ser>
-    auto serialize_into_json_stream(const Ser &ser, std::ostream &ostr) -> ::rustfp::Result<const Ser &, std::string> {
+    auto serialize_into_json_stream(
+        const Ser &ser,
+        std::ostream &ostr,
+        const json_format format) -> ::rustfp::Result<const Ser &, std::string> {
+
         auto val = details::make_json_dom_val();
-        SerializeValue(ser, val);
+        serialize_value(ser, val);
 
-        return serialize_json_into_stream(val, ostr)
+        return serialize_json_into_stream(val, ostr, format)
             .map([&ser](auto) { return std::cref(ser); });
     }
 
     template <class Ser>
-    auto serialize_into_json_file(const Ser &ser, const std::string &file_path) -> ::rustfp::Result<const Ser &, std::string> {
+    auto serialize_into_json_file(
+        const Ser &ser,
+        const std::string &file_path,
+        const json_format format) -> ::rustfp::Result<const Ser &, std::string> {
+
         auto val = details::make_json_dom_val();
-        SerializeValue(ser, val);
+        serialize_value(ser, val);
 
-        return serialize_json_into_file(val, file_path)
+        return serialize_json_into_file(val, file_path, format)
             .map([&ser](auto) { return std::cref(ser); });
     }
 }
@@ -0,0 +1,424 @@
+/**
+ * Contains JSON Lines (newline-delimited JSON) parsing functions,
+ * where every non-blank line holds one JSON value.
+ * @author Chen Weiguang
+ * @version 0.1.0
+ */
+
+#pragma once
+
+#include "sax.h"
+#include "serz_json.h"
+
+#include "rustfp/result.h"
+
+#include "rapidjson/reader.h"
+
+#ifndef FMT_HEADER_ONLY
+#define FMT_HEADER_ONLY
+#endif
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace serz {
+    // declaration section
+
+    /**
+     * Parses every line of the JSON Lines content from the given input stream
+     * into a new serializable value, and passes each value into the given
+     * function in input order. Blank lines are skipped. Only a single line is
+     * held in memory at any time, and the line buffer and parser state are
+     * reused between lines. str_ref values borrow from the line buffer and
+     * are only valid within the call of the function.
+     * Returns the number of parsed values, or the error of the first
+     * failing line. Serializable value must be default constructible.
+     */
+    template <class Ser, class Fn>
+    auto parse_from_jsonl_stream(std::istream &istr, Fn &&fn) -> ::rustfp::Result<size_t, std::string>;
+
+    /**
+     * Same as parse_from_jsonl_stream, except that the JSON Lines content
+     * is read from the given file path.
+     */
+    template <class Ser, class Fn>
+    auto parse_from_jsonl_file(const std::string &file_path, Fn &&fn) -> ::rustfp::Result<size_t, std::string>;
+
+    /**
+     * Options for parallel JSON Lines parsing.
+     */
+    struct jsonl_parallel_opts {
+        /**
+         * Number of worker threads, where 0 uses the number of hardware threads.
+         */
+        size_t thread_count = 0;
+
+        /**
+         * Minimum number of bytes read into each chunk, which is extended up to
+         * the next line break so that no line is split across chunks.
+         */
+        size_t chunk_size = 1 << 20;
+
+        /**
+         * Maximum number of chunks read ahead of the delivered values,
+         * where 0 uses twice the number of worker threads. Bounds the memory
+         * use to roughly this many chunks together with their parsed values.
+         */
+        size_t max_pending_chunks = 0;
+    };
+
+    /**
+     * Same as parse_from_jsonl_stream, except that the input is split at line
+     * breaks into chunks, which are parsed concurrently on a pool of worker
+     * threads. The parsed values are still passed into the given function in
+     * input order, on the calling thread. str_ref values borrow from the chunk
+     * buffer and are only valid within the call of the function.
+     */
+    template <class Ser, class Fn>
+    auto parse_from_jsonl_stream_parallel(
+        std::istream &istr,
+        Fn &&fn,
+        const jsonl_parallel_opts &opts = jsonl_parallel_opts()) -> ::rustfp::Result<size_t, std::string>;
+
+    /**
+     * Same as parse_from_jsonl_stream_parallel, except that the JSON Lines content
+     * is read from the given file path.
+     */
+    template <class Ser, class Fn>
+    auto parse_from_jsonl_file_parallel(
+        const std::string &file_path,
+        Fn &&fn,
+        const jsonl_parallel_opts &opts = jsonl_parallel_opts()) -> ::rustfp::Result<size_t, std::string>;
+
+    // implementation section
+
+    namespace details {
+        inline auto is_blank_line(const char line[], const size_t len) -> bool {
+            return std::all_of(line, line + len, [](const char c) {
+                return c == ' ' || c == '\t' || c == '\r';
+            });
+        }
+
+        inline auto is_blank_line(const std::string &line) -> bool {
+            return is_blank_line(line.data(), line.size());
+        }
+
+        /**
+         * Parsed values of a single chunk, or the error of its first failing line.
+         * Holds the chunk buffer, which str_ref values borrow from, so that it is
+         * kept alive until the values have been delivered. The buffer is held by
+         * pointer, so that it stays put while the result is moved around.
+         */
+        template <class Ser>
+        struct jsonl_chunk_res {
+            std::unique_ptr<std::string> chunk;
+            std::vector<Ser> sers;
+            size_t line_count = 0;
+            size_t err_line = 0;
+            std::string err_msg;
+        };
+
+        /**
+         * Parses every line of the chunk in-situ, where lines are delimited
+         * by line breaks that get overwritten with null characters.
+         */
+        template <class Ser>
+        auto parse_jsonl_chunk(std::string &chunk, rapidjson::Reader &reader, sax_ctx &ctx) -> jsonl_chunk_res<Ser> {
+            static constexpr auto FLAGS = json_parse_flags | rapidjson::kParseInsituFlag;
+
+            jsonl_chunk_res<Ser> res;
+            char *line = &chunk[0];
+            char *const chunk_end = line + chunk.size();
+
+            while (line < chunk_end) {
+                auto line_end = static_cast<char *>(std::memchr(line, '\n', chunk_end - line));
+
+                if (line_end == nullptr) {
+                    line_end = chunk_end;
+                }
+
+                *line_end = '\0';
+                ++res.line_count;
+
+                if (!is_blank_line(line, line_end - line)) {
+                    Ser ser;
+                    rapidjson::InsituStringStream line_istr(line);
+                    const auto parse_res = parse_json_sax_with<FLAGS>(ser, line_istr, reader, ctx);
+
+                    if (parse_res.is_err()) {
+                        res.err_line = res.line_count;
+                        res.err_msg = parse_res.get_err_unchecked();
+                        return res;
+                    }
+
+                    res.sers.push_back(std::move(ser));
+                }
+
+                line = line_end + 1;
+            }
+
+            return res;
+        }
+
+        /**
+         * Fixed pool of worker threads that parse the submitted chunks.
+         * Every worker reuses its own reader and context across chunks.
+         * Pending chunks are discarded on destruction.
+         */
+        template <class Ser>
+        class jsonl_worker_pool {
+        public:
+            explicit jsonl_worker_pool(const size_t thread_count) {
+                for (size_t i = 0; i < thread_count; ++i) {
+                    workers.emplace_back([this] { run(); });
+                }
+            }
+
+            ~jsonl_worker_pool() {
+                {
+                    std::lock_guard<std::mutex> lock(mut);
+                    stopped = true;
+                }
+
+                cv.notify_all();
+
+                for (auto &worker : workers) {
+                    worker.join();
+                }
+            }
+
+            auto submit(std::string &&chunk) -> std::future<jsonl_chunk_res<Ser>> {
+                task t{std::make_unique<std::string>(std::move(chunk)), std::promise<jsonl_chunk_res<Ser>>()};
+                auto fut = t.prom.get_future();
+
+                {
+                    std::lock_guard<std::mutex> lock(mut);
+                    tasks.push_back(std::move(t));
+                }
+
+                cv.notify_one();
+                return fut;
+            }
+
+        private:
+            struct task {
+                std::unique_ptr<std::string> chunk;
+                std::promise<jsonl_chunk_res<Ser>> prom;
+            };
+
+            void run() {
+                sax_ctx ctx(true);
+                rapidjson::Reader reader;
+
+                while (true) {
+                    std::unique_lock<std::mutex> lock(mut);
+                    cv.wait(lock, [this] { return stopped || !tasks.empty(); });
+
+                    if (stopped) {
+                        return;
+                    }
+
+                    auto t = std::move(tasks.front());
+                    tasks.pop_front();
+                    lock.unlock();
+
+                    try {
+                        auto res = parse_jsonl_chunk<Ser>(*t.chunk, reader, ctx);
+                        res.chunk = std::move(t.chunk);
+                        t.prom.set_value(std::move(res));
+                    } catch (...) {
+                        t.prom.set_exception(std::current_exception());
+                    }
+                }
+            }
+
+            std::mutex mut;
+            std::condition_variable cv;
+            std::deque<task> tasks;
+            bool stopped = false;
+            std::vector<std::thread> workers;
+        };
+
+        /**
+         * Reads the next chunk of at least chunk_size bytes that ends at a line break,
+         * or at the end of the stream. Bytes read past the last line break are kept
+         * in carry for the next chunk.
+         */
+        inline auto read_jsonl_chunk(std::istream &istr, const size_t chunk_size, std::string &carry) -> std::string {
+            std::string chunk(std::move(carry));
+            carry.clear();
+
+            while (istr) {
+                const auto prev_size = chunk.size();
+                chunk.resize(prev_size + chunk_size);
+                istr.read(&chunk[prev_size], static_cast<std::streamsize>(chunk_size));
+                chunk.resize(prev_size + static_cast<size_t>(istr.gcount()));
+
+                if (!istr) {
+                    break;
+                }
+
+                const auto last_nl = chunk.rfind('\n');
+
+                // keeps reading if a single line is longer than the chunk
+                if (last_nl != std::string::npos && last_nl >= prev_size) {
+                    carry.assign(chunk, last_nl + 1, std::string::npos);
+                    chunk.resize(last_nl + 1);
+                    break;
+                }
+            }
+
+            return chunk;
+        }
+    }
+
+    template <class Ser, class Fn>
+    auto parse_from_jsonl_stream(std::istream &istr, Fn &&fn) -> ::rustfp::Result<size_t, std::string> {
+        static constexpr auto FLAGS = details::json_parse_flags | rapidjson::kParseInsituFlag;
+
+        sax_ctx ctx(true);
+        rapidjson::Reader reader;
+        std::string line;
+        size_t line_num = 0;
+        size_t count = 0;
+
+        while (std::getline(istr, line)) {
+            ++line_num;
+
+            if (details::is_blank_line(line)) {
+                continue;
+            }
+
+            Ser ser;
+            rapidjson::InsituStringStream line_istr(&line[0]);
+            const auto parse_res = details::parse_json_sax_with<FLAGS>(ser, line_istr, reader, ctx);
+
+            if (parse_res.is_err()) {
+                return ::rustfp::Err(fmt::format("Error in parsing JSON line {}: {}",
+                    line_num, parse_res.get_err_unchecked()));
+            }
+
+            fn(std::move(ser));
+            ++count;
+        }
+
+        if (istr.bad()) {
+            return ::rustfp::Err(fmt::format("Error in reading JSON line {}", line_num + 1));
+        }
+
+        return ::rustfp::Ok(count);
+    }
+
+    template <class Ser, class Fn>
+    auto parse_from_jsonl_file(const std::string &file_path, Fn &&fn) -> ::rustfp::Result<size_t, std::string> {
+        std::ifstream file_stream(file_path, std::ios::binary);
+
+        if (!file_stream) {
+            return ::rustfp::Err(fmt::format("Cannot open file at '{}' for JSON Lines parsing", file_path));
+        }
+
+        return parse_from_jsonl_stream<Ser>(file_stream, std::forward<Fn>(fn));
+    }
+
+    template <class Ser, class Fn>
+    auto parse_from_jsonl_stream_parallel(
+        std::istream &istr,
+        Fn &&fn,
+        const jsonl_parallel_opts &opts) -> ::rustfp::Result<size_t, std::string> {
+
+        const auto thread_count = opts.thread_count > 0
+            ? opts.thread_count
+            : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+        const auto max_pending_chunks = opts.max_pending_chunks > 0
+            ? opts.max_pending_chunks
+            : thread_count * 2;
+
+        const auto chunk_size = std::max<size_t>(opts.chunk_size, 1);
+
+        details::jsonl_worker_pool<Ser> pool(thread_count);
+        std::deque<std::future<details::jsonl_chunk_res<Ser>>> pending;
+        std::string carry;
+        size_t line_num = 0;
+        size_t count = 0;
+
+        // delivers the values of the oldest chunk, in input order
+        const auto deliver_front = [&fn, &pending, &line_num, &count]() -> ::rustfp::Result<size_t, std::string> {
+            auto res = pending.front().get();
+            pending.pop_front();
+
+            for (auto &ser : res.sers) {
+                fn(std::move(ser));
+            }
+
+            count += res.sers.size();
+
+            if (res.err_line > 0) {
+                return ::rustfp::Err(fmt::format("Error in parsing JSON line {}: {}",
+                    line_num + res.err_line, res.err_msg));
+            }
+
+            line_num += res.line_count;
+            return ::rustfp::Ok(count);
+        };
+
+        while (istr || !carry.empty()) {
+            auto chunk = details::read_jsonl_chunk(istr, chunk_size, carry);
+
+            if (istr.bad()) {
+                return ::rustfp::Err(std::string("Error in reading JSON Lines content"));
+            }
+
+            if (!chunk.empty()) {
+                pending.push_back(pool.submit(std::move(chunk)));
+            }
+
+            if (pending.size() >= max_pending_chunks) {
+                const auto deliver_res = deliver_front();
+
+                if (deliver_res.is_err()) {
+                    return deliver_res;
+                }
+            }
+        }
+
+        while (!pending.empty()) {
+            const auto deliver_res = deliver_front();
+
+            if (deliver_res.is_err()) {
+                return deliver_res;
+            }
+        }
+
+        return ::rustfp::Ok(count);
+    }
+
+    template <class Ser, class Fn>
+    auto parse_from_jsonl_file_parallel(
+        const std::string &file_path,
+        Fn &&fn,
+        const jsonl_parallel_opts &opts) -> ::rustfp::Result<size_t, std::string> {
+
+        std::ifstream file_stream(file_path, std::ios::binary);
+
+        if (!file_stream) {
+            return ::rustfp::Err(fmt::format("Cannot open file at '{}' for JSON Lines parsing", file_path));
+        }
+
+        return parse_from_jsonl_stream_parallel<Ser>(file_stream, std::forward<Fn>(fn), opts);
+    }
+}
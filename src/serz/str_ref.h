@@ -0,0 +1,152 @@
+/**
+ * Contains non-owning string reference type, for borrowing string values
+ * from a buffer that outlives the reference.
+ * @author Chen Weiguang
+ * @version 0.1.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace serz {
+    // declaration section
+
+    /**
+     * Non-owning reference to a contiguous sequence of characters.
+     * Valid only as long as the referenced buffer is alive and unmodified.
+     */
+    class str_ref {
+    public:
+        /**
+         * Initializes this instance with an empty string.
+         */
+        str_ref();
+
+        /**
+         * Initializes this instance to refer to the given characters.
+         */
+        str_ref(const char str[], const size_t len);
+
+        /**
+         * Initializes this instance to refer to the given null terminated characters.
+         */
+        str_ref(const char str[]);
+
+        /**
+         * Initializes this instance to refer to the characters of the given string.
+         */
+        str_ref(const std::string &str);
+
+        /**
+         * Gets the pointer to the first referenced character.
+         */
+        auto data() const -> const char *;
+
+        /**
+         * Gets the number of referenced characters.
+         */
+        auto size() const -> size_t;
+
+        /**
+         * Checks if no characters are referenced.
+         */
+        auto empty() const -> bool;
+
+        /**
+         * Gets the pointer to the first referenced character.
+         */
+        auto begin() const -> const char *;
+
+        /**
+         * Gets the pointer past the last referenced character.
+         */
+        auto end() const -> const char *;
+
+        /**
+         * Copies the referenced characters into an owning string.
+         */
+        auto to_string() const -> std::string;
+
+    private:
+        /**
+         * Points to the first referenced character.
+         */
+        const char *str;
+
+        /**
+         * Number of referenced characters.
+         */
+        size_t len;
+    };
+
+    /**
+     * Checks if both references have the same characters.
+     */
+    auto operator==(const str_ref &lhs, const str_ref &rhs) -> bool;
+
+    /**
+     * Checks if both references have different characters.
+     */
+    auto operator!=(const str_ref &lhs, const str_ref &rhs) -> bool;
+
+    // implementation section
+
+    inline str_ref::str_ref() :
+        str(""),
+        len(0) {
+
+    }
+
+    inline str_ref::str_ref(const char str[], const size_t len) :
+        str(str),
+        len(len) {
+
+    }
+
+    inline str_ref::str_ref(const char str[]) :
+        str(str),
+        len(std::strlen(str)) {
+
+    }
+
+    inline str_ref::str_ref(const std::string &str) :
+        str(str.data()),
+        len(str.size()) {
+
+    }
+
+    inline auto str_ref::data() const -> const char * {
+        return str;
+    }
+
+    inline auto str_ref::size() const -> size_t {
+        return len;
+    }
+
+    inline auto str_ref::empty() const -> bool {
+        return len == 0;
+    }
+
+    inline auto str_ref::begin() const -> const char * {
+        return str;
+    }
+
+    inline auto str_ref::end() const -> const char * {
+        return str + len;
+    }
+
+    inline auto str_ref::to_string() const -> std::string {
+        return std::string(str, len);
+    }
+
+    inline auto operator==(const str_ref &lhs, const str_ref &rhs) -> bool {
+        return lhs.size() == rhs.size() && std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+    }
+
+    inline auto operator!=(const str_ref &lhs, const str_ref &rhs) -> bool {
+        return !(lhs == rhs);
+    }
+}
@@ -11,15 +11,17 @@
 
 #include "rustfp/option.h"
 
-#include "mapbox/variant.hpp"
-
 #ifndef FMT_HEADER_ONLY
 #define FMT_HEADER_ONLY
 #endif
 #include "fmt/format.h"
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -87,25 +89,92 @@ namespace serz {
      */
     struct dom_null_str_obj {};
 
+    /**
+     * Unparsed source of an object or array value, which is only parsed
+     * into the DOM value when its content is first accessed.
+     * The source must be valid, since parsing it cannot fail.
+     */
+    struct dom_lazy {
+        /**
+         * Holds the whole source content, which is shared among all
+         * the lazy values parsed from the same content.
+         */
+        std::shared_ptr<const std::string> src;
+
+        /**
+         * Position of the first character of the value in the source content.
+         */
+        size_t offset;
+
+        /**
+         * Number of characters of the value in the source content.
+         */
+        size_t len;
+
+        /**
+         * Indicates if the value is an object, otherwise it is an array.
+         */
+        bool is_obj;
+
+        /**
+         * Parses the value into its DOM value, whose nested objects
+         * and arrays may in turn be lazy.
+         */
+        auto (*materialize)(const dom_lazy &lazy) -> dom_val;
+    };
+
+    namespace details {
+        /**
+         * Reference count shared by all the out-of-line values of dom_val.
+         */
+        struct dom_box_base {
+            std::atomic<size_t> refs;
+        };
+
+        /**
+         * Out-of-line value of dom_val, which is shared among copies
+         * until one of them is modified.
+         */
+        template <class T>
+        struct dom_box : dom_box_base {
+            template <class... Args>
+            explicit dom_box(Args &&... args);
+
+            T val;
+        };
+
+        template <>
+        struct dom_box<dom_lazy>;
+    }
+
     /**
      * Intermediate representation of DOM value for possibly
      * multiple implementations such as XML and JSON.
+     * Each value takes 16 bytes: scalars are held inline, while objects,
+     * arrays, strings and lazy values are held out-of-line.
+     * Out-of-line values are shared by copies and only cloned, one level
+     * at a time, when accessed through a non-const accessor while shared.
+     * Hence a reference obtained from a non-const accessor must not be
+     * used for modification after the value has been copied.
+     * Values that share out-of-line values may be copied, destroyed and
+     * read through const accessors on different threads, where a shared
+     * lazy value is parsed only once by whichever reader comes first.
      */
     class dom_val
     {
     public:
         /**
-         * Defaulted default constructor.
+         * Initializes this instance with null value.
          */
         dom_val();
 
         /**
-         * Defaulted move constructs into this instance.
+         * Move constructs into this instance, leaving the other instance as null.
          */
-        dom_val(dom_val &&rhs) = default;
+        dom_val(dom_val &&rhs) noexcept;
 
         /**
-         * Copy constructs into this instance.
+         * Copy constructs into this instance, sharing the out-of-line value.
          */
         dom_val(const dom_val &rhs);
 
@@ -119,16 +188,32 @@ namespace serz {
          */
         dom_val(const dom_obj &obj);
 
+        /**
+         * Initializes this instance by moving in a given object value.
+         */
+        dom_val(dom_obj &&obj);
+
         /**
          * Initializes this instance with a given array value.
          */
         dom_val(const dom_arr &arr);
 
+        /**
+         * Initializes this instance by moving in a given array value.
+         */
+        dom_val(dom_arr &&arr);
+
         /**
          * Initializes this instance with a given variant of null, string 
          */
         dom_val(const dom_null_str_obj nso);
 
+        /**
+         * Initializes this instance with an object or array value
+         * which is only parsed when its content is first accessed.
+         */
+        dom_val(const dom_lazy &lazy);
+
         /**
          * Initializes this instance with a given boolean value.
          */
@@ -150,13 +235,22 @@ namespace serz {
         dom_val(const dom_str &str, const bool is_attr = false);
 
         /**
-         * Defaulted move assignment.
+         * Initializes this instance by moving in a given string value.
+         */
+        dom_val(dom_str &&str, const bool is_attr = false);
+
+        /**
+         * Releases the held value.
+         */
+        ~dom_val();
+
+        /**
+         * Move assignment, leaving the other instance as null.
          */
-        auto operator=(dom_val &&rhs) -> dom_val & = default;
+        auto operator=(dom_val &&rhs) noexcept -> dom_val &;
 
         /**
-         * Custom copy constructor which performs deep copying
-         * of all the held values in this instance.
+         * Copy assignment, sharing the out-of-line value.
          */
         auto operator=(const dom_val &rhs) -> dom_val &;
 
@@ -165,11 +259,21 @@ namespace serz {
          */
         auto operator=(const dom_obj &obj) -> dom_val &;
 
+        /**
+         * Moves new object value into this instance.
+         */
+        auto operator=(dom_obj &&obj) -> dom_val &;
+
         /**
          * Assigns new array value into this instance.
          */
         auto operator=(const dom_arr &arr) -> dom_val &;
 
+        /**
+         * Moves new array value into this instance.
+         */
+        auto operator=(dom_arr &&arr) -> dom_val &;
+
         /**
          * Assigns new boolean value into this instance.
          */
@@ -190,6 +294,11 @@ namespace serz {
          */
         auto operator=(const dom_str &str) -> dom_val &;
 
+        /**
+         * Moves new string value into this instance.
+         */
+        auto operator=(dom_str &&str) -> dom_val &;
+
         /**
          * Sets this instance to null.
          */
@@ -213,9 +322,17 @@ namespace serz {
 
         /**
          * Gets the current DOM type that the value is holding.
+         * Does not parse a lazy value.
          */
         auto get_type() const -> dom_val_type;
 
+        /**
+         * Checks if the value is an object or array that is not parsed yet.
+         * A lazy value that is parsed through a const accessor is only
+         * parsed once for all its copies, and is no longer lazy after.
+         */
+        auto is_lazy() const -> bool;
+
         /**
          * Checks if the value is holding is currently holding
          * the specified DOM type.
@@ -223,6 +340,20 @@ namespace serz {
         template <class DomType>
         auto is() const -> bool;
 
+        /**
+         * Calls the visitor with the held value as its exact DOM type, e.g. dom_obj &,
+         * so that the type is dispatched only once. The visitor must accept every DOM type,
+         * and all of its overloads must return the same type.
+         */
+        template <class Visitor>
+        auto visit(Visitor &&visitor) -> decltype(std::forward<Visitor>(visitor)(std::declval<dom_null &>()));
+
+        /**
+         * Same as visit, except that the held value is readonly.
+         */
+        template <class Visitor>
+        auto visit(Visitor &&visitor) const -> decltype(std::forward<Visitor>(visitor)(std::declval<const dom_null &>()));
+
         /**
          * Gets the underlying type value with checking.
          */
@@ -251,136 +382,512 @@ namespace serz {
 
     private:
         /**
-         * Holds the value from any of the possible the DOM value type.
+         * Tag of a lazy value, which follows the tags taken from dom_val_type.
+         */
+        static constexpr uint8_t LAZY_TAG = 8;
+
+        /**
+         * Masks the part of the tag that holds the type.
+         */
+        static constexpr uint8_t TYPE_MASK = 0x0f;
+
+        /**
+         * Marks the value as an attribute, which is meant only for
+         * XML serialization purposes.
+         */
+        static constexpr uint8_t ATTR_BIT = 0x80;
+
+        /**
+         * Holds the scalar value inline, or points to the out-of-line value.
+         */
+        union storage {
+            details::dom_box<dom_obj> *obj;
+            details::dom_box<dom_arr> *arr;
+            dom_bln bln;
+            dom_int itg;
+            dom_flt flt;
+            details::dom_box<dom_str> *str;
+            details::dom_box<dom_lazy> *lazy;
+        };
+
+        /**
+         * Wraps the type part of the tag, to keep the constructor taking
+         * it apart from the constructors taking scalar values.
+         */
+        struct raw_tag {
+            uint8_t type;
+        };
+
+        /**
+         * Initializes this instance with the given type tag and attribute flag.
+         * The storage is zeroed.
+         */
+        dom_val(const raw_tag raw, const bool is_attr);
+
+        /**
+         * Gets the type part of the tag.
+         */
+        auto type_tag() const -> uint8_t;
+
+        /**
+         * Replaces the held value with the value of the other instance,
+         * while keeping the attribute flag of this instance.
+         */
+        auto replace(dom_val &&rhs) -> dom_val &;
+
+        /**
+         * Gets the reference count of the out-of-line value, if any.
+         */
+        auto box() const -> details::dom_box_base *;
+
+        /**
+         * Drops the reference to the out-of-line value, if any,
+         * and frees it if it is the last one. Leaves the storage dangling.
+         */
+        void release();
+
+        /**
+         * Clones the out-of-line value if it is shared, so that it can be modified.
+         */
+        void detach();
+
+        /**
+         * Replaces the given out-of-line value with a clone, if it is shared.
          */
-        mapbox::util::variant<
-            mapbox::util::recursive_wrapper<dom_obj>,
-            mapbox::util::recursive_wrapper<dom_arr>,
-            dom_bln, dom_int, dom_flt, dom_str, dom_null, dom_null_str_obj> vts;
+        template <class T>
+        static void detach_box(details::dom_box<T> *&box);
 
         /**
-         * Meant only for XML serialization purposes.
-         * For serializing the node as an attribute.
+         * Drops the reference to the given out-of-line value, and frees it if it is the last one.
          */
-        bool is_attr = false;
+        template <class T>
+        static void unref_box(details::dom_box<T> *box);
+
+        /**
+         * Gets the held value as the given DOM type with no checking.
+         */
+        template <class DomType>
+        auto ref() -> DomType &;
+
+        /**
+         * Same as above ref, except returns const reference for
+         * non-mutating operations.
+         */
+        template <class DomType>
+        auto ref() const -> const DomType &;
+
+        /**
+         * Gets the value parsed from the lazy value, parsing it first if no
+         * reader has yet, or this value itself if it is not lazy.
+         * Safe for concurrent readers of the same lazy value.
+         */
+        auto resolve() const -> const dom_val &;
+
+        /**
+         * Replaces the lazy value with the value parsed from it,
+         * if the value is lazy, so that it can be modified.
+         */
+        void materialize();
+
+        /**
+         * Holds the value of any of the possible DOM value types.
+         */
+        storage data;
+
+        /**
+         * Type of the held value in the lower bits, and the attribute flag in the highest bit.
+         */
+        uint8_t tag;
     };
 
+    namespace details {
+        /**
+         * Out-of-line lazy value of dom_val, which also holds the value parsed
+         * from it, so that the readers of all its copies share a single parse.
+         */
+        template <>
+        struct dom_box<dom_lazy> : dom_box_base {
+            explicit dom_box(const dom_lazy &val);
+
+            dom_lazy val;
+
+            /**
+             * Guards the parse against concurrent readers.
+             */
+            std::once_flag parse_flag;
+
+            /**
+             * Set once the value has been parsed into parsed.
+             */
+            std::atomic<bool> is_parsed;
+
+            /**
+             * Value parsed from val, which is null until is_parsed is set.
+             */
+            dom_val parsed;
+        };
+    }
+
+    static_assert(sizeof(dom_val) <= 16, "dom_val must stay within 16 bytes");
+
     // implementation section
 
+    namespace details {
+        template <class T>
+        template <class... Args>
+        dom_box<T>::dom_box(Args &&... args) :
+            val(std::forward<Args>(args)...) {
+
+            refs.store(1, std::memory_order_relaxed);
+        }
+
+        inline dom_box<dom_lazy>::dom_box(const dom_lazy &val) :
+            val(val) {
+
+            refs.store(1, std::memory_order_relaxed);
+            is_parsed.store(false, std::memory_order_relaxed);
+        }
+    }
+
     inline dom_val::dom_val() : dom_val(dom_null()) {
 
     }
 
+    inline dom_val::dom_val(const raw_tag raw, const bool is_attr) :
+        tag(static_cast<uint8_t>(raw.type | (is_attr ? ATTR_BIT : 0))) {
+
+        data.itg = 0;
+    }
+
+    inline dom_val::dom_val(dom_val &&rhs) noexcept :
+        data(rhs.data),
+        tag(rhs.tag) {
+
+        rhs.tag = static_cast<uint8_t>(dom_val_type::null_type);
+    }
+
     inline dom_val::dom_val(const dom_val &rhs) :
-        vts(rhs.vts),
-        is_attr(rhs.is_attr) {
+        data(rhs.data),
+        tag(rhs.tag) {
 
+        if (const auto shared = box()) {
+            shared->refs.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
-    inline dom_val::dom_val(const dom_null nll) :
-        vts(nll) {
+    inline dom_val::dom_val(const dom_null) :
+        dom_val(raw_tag{static_cast<uint8_t>(dom_val_type::null_type)}, false) {
 
     }
 
     inline dom_val::dom_val(const dom_obj &obj) :
-        vts(obj) {
+        dom_val(raw_tag{static_cast<uint8_t>(dom_val_type::obj_type)}, false) {
+
+        data.obj = new details::dom_box<dom_obj>(obj);
+    }
+
+    inline dom_val::dom_val(dom_obj &&obj) :
+        dom_val(raw_tag{static_cast<uint8_t>(dom_val_type::obj_type)}, false) {
 
+        data.obj = new details::dom_box<dom_obj>(std::move(obj));
     }
 
     inline dom_val::dom_val(const dom_arr &arr) :
-        vts(arr) {
+        dom_val(raw_tag{static_cast<uint8_t>(dom_val_type::arr_type)}, false) {
 
+        data.arr = new details::dom_box<dom_arr>(arr);
     }
 
-    inline dom_val::dom_val(const dom_null_str_obj nso) :
-        vts(nso) {
+    inline dom_val::dom_val(dom_arr &&arr) :
+        dom_val(raw_tag{static_cast<uint8_t>(dom_val_type::arr_type)}, false) {
 
+        data.arr = new details::dom_box<dom_arr>(std::move(arr));
+    }
+
+    inline dom_val::dom_val(const dom_null_str_obj) :
+        dom_val(raw_tag{static_cast<uint8_t>(dom_val_type::null_string_obj_type)}, false) {
+
+    }
+
+    inline dom_val::dom_val(const dom_lazy &lazy) :
+        dom_val(raw_tag{LAZY_TAG}, false) {
+
+        data.lazy = new details::dom_box<dom_lazy>(lazy);
     }
 
     inline dom_val::dom_val(const dom_bln &bln, const bool is_attr) :
-        vts(bln),
-        is_attr(is_attr) {
+        dom_val(raw_tag{static_cast<uint8_t>(dom_val_type::bool_type)}, is_attr) {
 
+        data.bln = bln;
     }
 
     inline dom_val::dom_val(const dom_int &itg, const bool is_attr) :
-        vts(itg),
-        is_attr(is_attr) {
+        dom_val(raw_tag{static_cast<uint8_t>(dom_val_type::int_type)}, is_attr) {
 
+        data.itg = itg;
     }
 
     inline dom_val::dom_val(const dom_flt &flt, const bool is_attr) :
-        vts(flt),
-        is_attr(is_attr) {
+        dom_val(raw_tag{static_cast<uint8_t>(dom_val_type::flt_type)}, is_attr) {
 
+        data.flt = flt;
     }
 
     inline dom_val::dom_val(const dom_str &str, const bool is_attr) :
-        vts(str),
-        is_attr(is_attr) {
+        dom_val(raw_tag{static_cast<uint8_t>(dom_val_type::str_type)}, is_attr) {
 
+        data.str = new details::dom_box<dom_str>(str);
     }
 
-    inline auto dom_val::operator=(const dom_val &rhs) -> dom_val & {
-        vts = rhs.vts;
-        is_attr = rhs.is_attr;
+    inline dom_val::dom_val(dom_str &&str, const bool is_attr) :
+        dom_val(raw_tag{static_cast<uint8_t>(dom_val_type::str_type)}, is_attr) {
+
+        data.str = new details::dom_box<dom_str>(std::move(str));
+    }
+
+    inline dom_val::~dom_val() {
+        release();
+    }
+
+    inline auto dom_val::operator=(dom_val &&rhs) noexcept -> dom_val & {
+        // rhs may be owned by this instance, so it is taken over before releasing
+        dom_val tmp(std::move(rhs));
+
+        std::swap(data, tmp.data);
+        std::swap(tag, tmp.tag);
         return *this;
     }
 
+    inline auto dom_val::operator=(const dom_val &rhs) -> dom_val & {
+        return *this = dom_val(rhs);
+    }
+
     inline auto dom_val::operator=(const dom_null nll) -> dom_val & {
-        vts = nll;
-        return *this;
+        return replace(dom_val(nll));
+    }
+
+    inline auto dom_val::operator=(const dom_null_str_obj nso) -> dom_val & {
+        return replace(dom_val(nso));
     }
 
     inline auto dom_val::operator=(const dom_obj &obj) -> dom_val & {
-        vts = obj;
-        return *this;
+        return replace(dom_val(obj));
+    }
+
+    inline auto dom_val::operator=(dom_obj &&obj) -> dom_val & {
+        return replace(dom_val(std::move(obj)));
     }
 
     inline auto dom_val::operator=(const dom_arr &arr) -> dom_val & {
-        vts = arr;
-        return *this;
+        return replace(dom_val(arr));
+    }
+
+    inline auto dom_val::operator=(dom_arr &&arr) -> dom_val & {
+        return replace(dom_val(std::move(arr)));
     }
 
     inline auto dom_val::operator=(const dom_bln &bln) -> dom_val & {
-        vts = bln;
-        return *this;
+        return replace(dom_val(bln));
     }
 
     inline auto dom_val::operator=(const dom_int &itg) -> dom_val & {
-        vts = itg;
-        return *this;
+        return replace(dom_val(itg));
     }
 
     inline auto dom_val::operator=(const dom_flt &flt) -> dom_val & {
-        vts = flt;
-        return *this;
+        return replace(dom_val(flt));
     }
 
     inline auto dom_val::operator=(const dom_str &str) -> dom_val & {
-        vts = str;
-        return *this;
+        return replace(dom_val(str));
+    }
+
+    inline auto dom_val::operator=(dom_str &&str) -> dom_val & {
+        return replace(dom_val(std::move(str)));
     }
 
     inline auto dom_val::is_attribute() const -> bool {
-        return is_attr;
+        return (tag & ATTR_BIT) != 0;
     }
 
     inline auto dom_val::set_attribute(const bool is_attr) -> dom_val & {
-        this->is_attr = is_attr;
+        tag = static_cast<uint8_t>(is_attr ? tag | ATTR_BIT : tag & ~ATTR_BIT);
         return *this;
     }
 
     inline auto dom_val::get_type() const -> dom_val_type {
-        return
-            vts.is<dom_obj>() ? dom_val_type::obj_type :
-            vts.is<dom_arr>() ? dom_val_type::arr_type :
-            vts.is<dom_bln>() ? dom_val_type::bool_type :
-            vts.is<dom_int>() ? dom_val_type::int_type :
-            vts.is<dom_flt>() ? dom_val_type::flt_type :
-            vts.is<dom_str>() ? dom_val_type::str_type :
-            vts.is<dom_null>() ? dom_val_type::null_type :
-            dom_val_type::null_string_obj_type;
+        // the type part of the tag is the dom_val_type itself, except for lazy values
+        if (type_tag() == LAZY_TAG) {
+            return data.lazy->val.is_obj ? dom_val_type::obj_type : dom_val_type::arr_type;
+        }
+
+        return static_cast<dom_val_type>(type_tag());
+    }
+
+    inline auto dom_val::is_lazy() const -> bool {
+        return type_tag() == LAZY_TAG && !data.lazy->is_parsed.load(std::memory_order_acquire);
+    }
+
+    inline auto dom_val::type_tag() const -> uint8_t {
+        return tag & TYPE_MASK;
+    }
+
+    inline auto dom_val::replace(dom_val &&rhs) -> dom_val & {
+        rhs.set_attribute(is_attribute());
+        return *this = std::move(rhs);
+    }
+
+    inline auto dom_val::box() const -> details::dom_box_base * {
+        switch (type_tag()) {
+        case static_cast<uint8_t>(dom_val_type::obj_type):
+            return data.obj;
+
+        case static_cast<uint8_t>(dom_val_type::arr_type):
+            return data.arr;
+
+        case static_cast<uint8_t>(dom_val_type::str_type):
+            return data.str;
+
+        case LAZY_TAG:
+            return data.lazy;
+
+        default:
+            return nullptr;
+        }
+    }
+
+    inline void dom_val::release() {
+        switch (type_tag()) {
+        case static_cast<uint8_t>(dom_val_type::obj_type):
+            unref_box(data.obj);
+            break;
+
+        case static_cast<uint8_t>(dom_val_type::arr_type):
+            unref_box(data.arr);
+            break;
+
+        case static_cast<uint8_t>(dom_val_type::str_type):
+            unref_box(data.str);
+            break;
+
+        case LAZY_TAG:
+            unref_box(data.lazy);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    inline void dom_val::detach() {
+        switch (type_tag()) {
+        case static_cast<uint8_t>(dom_val_type::obj_type):
+            detach_box(data.obj);
+            break;
+
+        case static_cast<uint8_t>(dom_val_type::arr_type):
+            detach_box(data.arr);
+            break;
+
+        case static_cast<uint8_t>(dom_val_type::str_type):
+            detach_box(data.str);
+            break;
+
+        default:
+            // lazy values are never modified in place
+            break;
+        }
+    }
+
+    template <class T>
+    void dom_val::detach_box(details::dom_box<T> *&box) {
+        if (box->refs.load(std::memory_order_acquire) > 1) {
+            // only this level is cloned, the children are shared in turn
+            const auto cloned = new details::dom_box<T>(box->val);
+            unref_box(box);
+            box = cloned;
+        }
+    }
+
+    template <class T>
+    void dom_val::unref_box(details::dom_box<T> *box) {
+        if (box->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete box;
+        }
+    }
+
+    template <>
+    inline auto dom_val::ref<dom_obj>() -> dom_obj & {
+        return data.obj->val;
+    }
+
+    template <>
+    inline auto dom_val::ref<dom_arr>() -> dom_arr & {
+        return data.arr->val;
+    }
+
+    template <>
+    inline auto dom_val::ref<dom_bln>() -> dom_bln & {
+        return data.bln;
+    }
+
+    template <>
+    inline auto dom_val::ref<dom_int>() -> dom_int & {
+        return data.itg;
+    }
+
+    template <>
+    inline auto dom_val::ref<dom_flt>() -> dom_flt & {
+        return data.flt;
+    }
+
+    template <>
+    inline auto dom_val::ref<dom_str>() -> dom_str & {
+        return data.str->val;
+    }
+
+    template <>
+    inline auto dom_val::ref<dom_null>() -> dom_null & {
+        // stateless, so every null value can share the same instance
+        static dom_null nll;
+        return nll;
+    }
+
+    template <>
+    inline auto dom_val::ref<dom_null_str_obj>() -> dom_null_str_obj & {
+        static dom_null_str_obj nso;
+        return nso;
+    }
+
+    template <class DomType>
+    auto dom_val::ref() const -> const DomType & {
+        // the held value is only read through the returned reference
+        return const_cast<dom_val *>(this)->ref<DomType>();
+    }
+
+    inline auto dom_val::resolve() const -> const dom_val & {
+        if (type_tag() != LAZY_TAG) {
+            return *this;
+        }
+
+        const auto box = data.lazy;
+
+        std::call_once(box->parse_flag, [box] {
+            box->parsed = box->val.materialize(box->val);
+            box->is_parsed.store(true, std::memory_order_release);
+        });
+
+        return box->parsed;
+    }
+
+    inline void dom_val::materialize() {
+        if (type_tag() == LAZY_TAG) {
+            // shares the parsed value, which is cloned on modification as usual
+            dom_val val = resolve();
+
+            // the lazy value is released by the assignment
+            replace(std::move(val));
+        }
     }
 
     template <>
@@ -423,27 +930,99 @@ namespace serz {
         return get_type() == dom_val_type::null_string_obj_type;
     }
 
+    template <class Visitor>
+    auto dom_val::visit(Visitor &&visitor) -> decltype(std::forward<Visitor>(visitor)(std::declval<dom_null &>())) {
+        materialize();
+        detach();
+
+        switch (get_type()) {
+        case dom_val_type::obj_type:
+            return std::forward<Visitor>(visitor)(ref<dom_obj>());
+
+        case dom_val_type::arr_type:
+            return std::forward<Visitor>(visitor)(ref<dom_arr>());
+
+        case dom_val_type::bool_type:
+            return std::forward<Visitor>(visitor)(ref<dom_bln>());
+
+        case dom_val_type::int_type:
+            return std::forward<Visitor>(visitor)(ref<dom_int>());
+
+        case dom_val_type::flt_type:
+            return std::forward<Visitor>(visitor)(ref<dom_flt>());
+
+        case dom_val_type::str_type:
+            return std::forward<Visitor>(visitor)(ref<dom_str>());
+
+        case dom_val_type::null_string_obj_type:
+            return std::forward<Visitor>(visitor)(ref<dom_null_str_obj>());
+
+        default:
+            return std::forward<Visitor>(visitor)(ref<dom_null>());
+        }
+    }
+
+    template <class Visitor>
+    auto dom_val::visit(Visitor &&visitor) const -> decltype(std::forward<Visitor>(visitor)(std::declval<const dom_null &>())) {
+        if (type_tag() == LAZY_TAG) {
+            return resolve().visit(std::forward<Visitor>(visitor));
+        }
+
+        switch (get_type()) {
+        case dom_val_type::obj_type:
+            return std::forward<Visitor>(visitor)(static_cast<const dom_obj &>(ref<dom_obj>()));
+
+        case dom_val_type::arr_type:
+            return std::forward<Visitor>(visitor)(static_cast<const dom_arr &>(ref<dom_arr>()));
+
+        case dom_val_type::bool_type:
+            return std::forward<Visitor>(visitor)(static_cast<const dom_bln &>(ref<dom_bln>()));
+
+        case dom_val_type::int_type:
+            return std::forward<Visitor>(visitor)(static_cast<const dom_int &>(ref<dom_int>()));
+
+        case dom_val_type::flt_type:
+            return std::forward<Visitor>(visitor)(static_cast<const dom_flt &>(ref<dom_flt>()));
+
+        case dom_val_type::str_type:
+            return std::forward<Visitor>(visitor)(static_cast<const dom_str &>(ref<dom_str>()));
+
+        case dom_val_type::null_string_obj_type:
+            return std::forward<Visitor>(visitor)(static_cast<const dom_null_str_obj &>(ref<dom_null_str_obj>()));
+
+        default:
+            return std::forward<Visitor>(visitor)(static_cast<const dom_null &>(ref<dom_null>()));
+        }
+    }
+
     template <class DomType>
     auto dom_val::get() -> ::rustfp::Option<DomType &> {
+        materialize();
+        detach();
+
         return is<DomType>()
-            ? ::rustfp::Some(std::ref(vts.get_unchecked<DomType>()))
+            ? ::rustfp::Some(std::ref(ref<DomType>()))
             : ::rustfp::None;
     }
 
     template <class DomType>
     auto dom_val::get_unchecked() -> DomType & {
-        return vts.get_unchecked<DomType>();
+        materialize();
+        detach();
+        return ref<DomType>();
     }
 
     template <class DomType>
     auto dom_val::get() const -> ::rustfp::Option<const DomType &> {
-        return is<DomType>()
-            ? ::rustfp::Some(std::ref(vts.get_unchecked<DomType>()))
+        const auto &val = resolve();
+
+        return val.is<DomType>()
+            ? ::rustfp::Some(std::cref(val.ref<DomType>()))
             : ::rustfp::None;
     }
 
     template <class DomType>
     auto dom_val::get_unchecked() const -> const DomType & {
-        return vts.get_unchecked<DomType>();
+        return resolve().ref<DomType>();
     }
 }
@@ -5,12 +5,32 @@
 
 #include "rustfp/result.h"
 
+#include <atomic>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 
 // serz
 using serz::parse_from_json_content_and_ret;
+using serz::parse_from_json_array_content;
+using serz::parse_from_json_content_lazy_and_ret;
+using serz::parse_from_json_content_sax_and_ret;
+using serz::parse_from_json_file_and_ret;
+using serz::parse_from_json_file_sax_and_ret;
+using serz::parse_from_json_insitu_and_ret;
+using serz::parse_from_jsonl_stream;
+using serz::parse_from_jsonl_stream_parallel;
+using serz::parse_json;
+using serz::parse_json_detailed;
+using serz::parse_json_lazy;
+using serz::serialize_json;
+using serz::serialize_json_into_buffer;
+using serz::serialize_json_into_stream;
+using serz::str_ref;
 
 // rustfp
 using rustfp::Err;
@@ -31,6 +51,108 @@ struct X {
     bool a;
 };
 
+struct Y {
+    str_ref name;
+    std::vector<str_ref> tags;
+};
+
+struct Z {
+    size_t len;
+    std::vector<const char *> *bufs;
+};
+
+struct W {
+    int id;
+    double ratio;
+    string name;
+    std::vector<int> vals;
+    rustfp::Option<string> note;
+};
+
+SERZ_FIELDS(W, id, ratio, name, vals, note)
+
+struct Order {
+    double price;
+};
+
+struct Book {
+    std::vector<Order> orders;
+};
+
+SERZ_FIELDS(Order, price)
+SERZ_FIELDS(Book, orders)
+
+struct C {
+    static size_t copy_count;
+    static size_t move_count;
+
+    string name;
+    std::vector<int> vals;
+
+    C() = default;
+
+    C(const C &rhs) :
+        name(rhs.name),
+        vals(rhs.vals) {
+
+        ++copy_count;
+    }
+
+    C(C &&rhs) noexcept :
+        name(move(rhs.name)),
+        vals(move(rhs.vals)) {
+
+        ++move_count;
+    }
+
+    auto operator=(const C &rhs) -> C & {
+        name = rhs.name;
+        vals = rhs.vals;
+        ++copy_count;
+        return *this;
+    }
+
+    auto operator=(C &&rhs) noexcept -> C & {
+        name = move(rhs.name);
+        vals = move(rhs.vals);
+        ++move_count;
+        return *this;
+    }
+};
+
+size_t C::copy_count = 0;
+size_t C::move_count = 0;
+
+SERZ_FIELDS(C, name, vals)
+
+struct R {
+    std::vector<int> vals;
+};
+
+struct M {
+    static size_t parse_count;
+    static size_t move_count;
+
+    int val = 0;
+
+    M() = default;
+
+    M(M &&rhs) noexcept :
+        val(rhs.val) {
+
+        ++move_count;
+    }
+
+    auto operator=(M &&rhs) noexcept -> M & {
+        val = rhs.val;
+        ++move_count;
+        return *this;
+    }
+};
+
+size_t M::parse_count = 0;
+size_t M::move_count = 0;
+
 namespace serz {
     auto parse_value(X &ser, const dom_val &val) -> Result<X &, string> {
         return as_obj(val) &
@@ -40,6 +162,47 @@ namespace serz {
             parse_nvp(ser.a, "a") &
             done_obj(ser);
     }
+
+    auto parse_fields(X &ser, sax_fields &fields) -> sax_fields & {
+        return fields &
+            parse_nvp(ser.x, "x") &
+            parse_nvp(ser.y, "y") &
+            parse_nvp(ser.z, "z") &
+            parse_nvp(ser.a, "a");
+    }
+
+    auto parse_fields(Y &ser, sax_fields &fields) -> sax_fields & {
+        return fields &
+            parse_nvp(ser.name, "name") &
+            parse_nvp(ser.tags, "tags");
+    }
+
+    auto parse_fields(R &ser, sax_fields &fields) -> sax_fields & {
+        // names are built at runtime and freed before the keys are matched
+        for (size_t i = 0; i < ser.vals.size(); ++i) {
+            fields & parse_nvp(ser.vals[i], fmt::format("v{}", i));
+        }
+
+        return fields;
+    }
+
+    auto parse_ints(std::vector<int> &ser, const dom_val &val) -> Result<std::vector<int> &, string> {
+        // delegates to the provided parse_value while failing with a plain message
+        return parse_value(ser, val);
+    }
+
+    auto parse_value(M &ser, const dom_val &val) -> Result<M &, parse_error> {
+        ++M::parse_count;
+        return parse_value(ser.val, val).map([&ser](int &) { return std::ref(ser); });
+    }
+
+    auto serialize_value(const Z &ser, dom_val &val) -> dom_val & {
+        // records the buffer to check that it is moved rather than copied
+        dom_str str(ser.len, 'z');
+        ser.bufs->push_back(str.data());
+        val = std::move(str);
+        return val;
+    }
 }
 
 // test cases
@@ -65,4 +228,978 @@ TEST_CASE("Parse X", "[parse_X]") {
     REQUIRE(0.5 == x.y);
     REQUIRE("Hello World" == x.z);
     REQUIRE(!x.a);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Parse X via SAX", "[parse_X_sax]") {
+    static constexpr auto CONTENT = "["
+        "{\"z\": \"Hello\", \"x\": 1, \"y\": 0.5, \"a\": true, \"b\": [1, {}]},"
+        "{\"x\": 2, \"y\": 1.5, \"z\": null, \"a\": \"false\"}"
+        "]";
+
+    auto parse_res = parse_from_json_content_sax_and_ret<std::vector<X>>(CONTENT);
+
+    parse_res.match_err([](const auto &err_msg) {
+        cerr << err_msg << '\n';
+    });
+
+    REQUIRE(parse_res.is_ok());
+
+    const auto xs = move(parse_res).unwrap_unchecked();
+    REQUIRE(2 == xs.size());
+    REQUIRE(1 == xs[0].x);
+    REQUIRE(0.5 == xs[0].y);
+    REQUIRE("Hello" == xs[0].z);
+    REQUIRE(xs[0].a);
+    REQUIRE(2 == xs[1].x);
+    REQUIRE(1.5 == xs[1].y);
+    REQUIRE(xs[1].z.empty());
+    REQUIRE(!xs[1].a);
+
+    REQUIRE(parse_from_json_content_sax_and_ret<X>("{\"x\": 1}").is_err());
+}
+
+TEST_CASE("Parse runtime field names via SAX", "[parse_sax_runtime_names]") {
+    R r;
+    r.vals.resize(3);
+
+    REQUIRE(serz::parse_from_json_content_sax(r, R"({"v2": 3, "v0": 1, "v1": 2})").is_ok());
+    REQUIRE((std::vector<int>{1, 2, 3}) == r.vals);
+}
+
+TEST_CASE("Parse duplicated keys into dom_val via SAX", "[parse_dom_val_sax_duplicate]") {
+    static constexpr auto CONTENT =
+        "{\"a\":1,\"a\":{\"b\":2,\"b\":{}},\"c\":[1],\"c\":[2,{\"a\":[]}],\"d\":{\"e\":[3],\"e\":[[4]]}}";
+
+    static constexpr auto EXPECTED = "{\"a\":1,\"c\":[1],\"d\":{\"e\":[3]}}";
+
+    // the first of any duplicated keys is kept, even when the later value is an object or array
+    auto parse_res = parse_from_json_content_sax_and_ret<serz::dom_val>(CONTENT);
+    REQUIRE(parse_res.is_ok());
+    REQUIRE(EXPECTED == serialize_json(move(parse_res).unwrap_unchecked(), serz::json_format::compact));
+
+    REQUIRE(EXPECTED == serialize_json(parse_json(CONTENT).unwrap_unchecked(), serz::json_format::compact));
+}
+
+TEST_CASE("Parse duplicated keys with both engines", "[parse_duplicate_keys]") {
+    static constexpr auto X_CONTENT = "{\"x\": 1, \"y\": 0.5, \"z\": \"a\", \"a\": true, \"x\": 2, \"z\": {\"b\": []}}";
+    static constexpr auto MAP_CONTENT = "{\"a\": 1, \"b\": 2, \"a\": 3, \"b\": [4]}";
+
+    // the first of any duplicated keys is kept by either engine
+    const auto dom_x = parse_from_json_content_and_ret<X>(X_CONTENT).unwrap_unchecked();
+    const auto sax_x = parse_from_json_content_sax_and_ret<X>(X_CONTENT).unwrap_unchecked();
+    REQUIRE(1 == dom_x.x);
+    REQUIRE("a" == dom_x.z);
+    REQUIRE(1 == sax_x.x);
+    REQUIRE("a" == sax_x.z);
+
+    using int_map = std::unordered_map<string, int>;
+    const auto dom_map = parse_from_json_content_and_ret<int_map>(MAP_CONTENT).unwrap_unchecked();
+    const auto sax_map = parse_from_json_content_sax_and_ret<int_map>(MAP_CONTENT).unwrap_unchecked();
+    REQUIRE((int_map{{"a", 1}, {"b", 2}}) == dom_map);
+    REQUIRE(dom_map == sax_map);
+}
+
+TEST_CASE("Parse Y in-situ", "[parse_Y_insitu]") {
+    char content[] = "{\"name\": \"Hello\\tWorld\", \"tags\": [\"a\", \"bc\"]}";
+
+    auto parse_res = parse_from_json_insitu_and_ret<Y>(content);
+
+    parse_res.match_err([](const auto &err_msg) {
+        cerr << err_msg << '\n';
+    });
+
+    REQUIRE(parse_res.is_ok());
+
+    const auto y = move(parse_res).unwrap_unchecked();
+    REQUIRE(str_ref("Hello\tWorld") == y.name);
+    REQUIRE(y.name.data() > content);
+    REQUIRE(y.name.data() < content + sizeof(content));
+    REQUIRE(2 == y.tags.size());
+    REQUIRE(str_ref("a") == y.tags[0]);
+    REQUIRE(str_ref("bc") == y.tags[1]);
+
+    REQUIRE(parse_from_json_content_sax_and_ret<Y>("{\"name\": \"a\", \"tags\": []}").is_err());
+
+    // the decoded content is not quoted back
+    char bad_content[] = "{\"name\": \"a\\nb\", \"tags\": [\"c\"] ]";
+
+    const auto bad_res = parse_from_json_insitu_and_ret<Y>(bad_content);
+    REQUIRE(bad_res.is_err());
+    REQUIRE(bad_res.get_err_unchecked().find("at offset 31") != string::npos);
+    REQUIRE(bad_res.get_err_unchecked().find("Near") == string::npos);
+}
+
+TEST_CASE("Parse X from file", "[parse_X_file]") {
+    static constexpr auto FILE_PATH = "serz_unit_test_parse_X_file.json";
+
+    {
+        std::ofstream file_stream(FILE_PATH);
+        file_stream << "{\"x\": 7, \"y\": 2.5, \"z\": \"File\", \"a\": true}";
+    }
+
+    auto parse_res = parse_from_json_file_and_ret<X>(FILE_PATH);
+    auto sax_parse_res = parse_from_json_file_sax_and_ret<X>(FILE_PATH);
+    std::remove(FILE_PATH);
+
+    REQUIRE(parse_res.is_ok());
+    REQUIRE(sax_parse_res.is_ok());
+
+    const auto x = move(parse_res).unwrap_unchecked();
+    const auto sax_x = move(sax_parse_res).unwrap_unchecked();
+    REQUIRE(7 == x.x);
+    REQUIRE(2.5 == x.y);
+    REQUIRE("File" == x.z);
+    REQUIRE(x.a);
+    REQUIRE(x.z == sax_x.z);
+
+    REQUIRE(parse_from_json_file_and_ret<X>(FILE_PATH).is_err());
+}
+
+TEST_CASE("Serialize JSON", "[serialize_json]") {
+    static constexpr auto CONTENT = "{\"x\":[1,2.5,\"a\\\"b\",null],\"y\":{\"z\":true},\"w\":{}}";
+
+    auto parse_res = parse_json(CONTENT);
+    REQUIRE(parse_res.is_ok());
+
+    const auto val = move(parse_res).unwrap_unchecked();
+    REQUIRE(CONTENT == serialize_json(val, serz::json_format::compact));
+    REQUIRE(parse_json(serialize_json(val)).is_ok());
+
+    std::ostringstream ostr;
+    REQUIRE(serialize_json_into_stream(val, ostr, serz::json_format::compact).is_ok());
+    REQUIRE(CONTENT == ostr.str());
+
+    char buf[64];
+    auto buf_res = serialize_json_into_buffer(val, buf, sizeof(buf), serz::json_format::compact);
+    REQUIRE(buf_res.is_ok());
+    REQUIRE(CONTENT == string(buf, move(buf_res).unwrap_unchecked()));
+
+    REQUIRE(serialize_json_into_buffer(val, buf, 8, serz::json_format::compact).is_err());
+}
+
+TEST_CASE("Parse X from JSON Lines", "[parse_X_jsonl]") {
+    std::istringstream istr(
+        "{\"x\": 1, \"y\": 0.5, \"z\": \"a\", \"a\": true}\n"
+        "\r\n"
+        "{\"x\": 2, \"y\": 1.5, \"z\": \"b\", \"a\": false}\r\n"
+        "{\"x\": 3, \"y\": 2.5, \"z\": \"c\", \"a\": true}");
+
+    std::vector<X> xs;
+
+    auto parse_res = parse_from_jsonl_stream<X>(istr, [&xs](X &&x) {
+        xs.push_back(move(x));
+    });
+
+    REQUIRE(parse_res.is_ok());
+    REQUIRE(3 == move(parse_res).unwrap_unchecked());
+    REQUIRE(3 == xs.size());
+    REQUIRE(1 == xs[0].x);
+    REQUIRE("b" == xs[1].z);
+    REQUIRE(2.5 == xs[2].y);
+
+    std::istringstream bad_istr("{\"x\": 1, \"y\": 0.5, \"z\": \"a\", \"a\": true}\n{\"x\": }\n");
+    size_t count = 0;
+
+    auto bad_parse_res = parse_from_jsonl_stream<X>(bad_istr, [&count](X &&) { ++count; });
+    REQUIRE(bad_parse_res.is_err());
+    REQUIRE(1 == count);
+}
+
+TEST_CASE("Parse X from JSON Lines in parallel", "[parse_X_jsonl_parallel]") {
+    static constexpr auto LINE_COUNT = 1000;
+
+    std::string content;
+
+    for (int i = 0; i < LINE_COUNT; ++i) {
+        content += "{\"x\": " + std::to_string(i) + ", \"y\": 0.5, \"z\": \"abc\", \"a\": true}\n";
+    }
+
+    serz::jsonl_parallel_opts opts;
+    opts.thread_count = 4;
+    opts.chunk_size = 256;
+    opts.max_pending_chunks = 3;
+
+    std::istringstream istr(content);
+    std::vector<X> xs;
+
+    auto parse_res = parse_from_jsonl_stream_parallel<X>(istr, [&xs](X &&x) {
+        xs.push_back(move(x));
+    }, opts);
+
+    REQUIRE(parse_res.is_ok());
+    REQUIRE(LINE_COUNT == move(parse_res).unwrap_unchecked());
+    REQUIRE(LINE_COUNT == xs.size());
+
+    for (int i = 0; i < LINE_COUNT; ++i) {
+        REQUIRE(i == xs[i].x);
+    }
+
+    std::istringstream bad_istr(content + "\n{\"x\": }\n" + content);
+    auto bad_parse_res = parse_from_jsonl_stream_parallel<X>(bad_istr, [](X &&) {}, opts);
+
+    REQUIRE(bad_parse_res.is_err());
+    bad_parse_res.match_err([](const auto &err_msg) {
+        REQUIRE(err_msg.find("line 1002") != string::npos);
+    });
+}
+
+TEST_CASE("Parse Y from JSON Lines in parallel", "[parse_Y_jsonl_parallel]") {
+    static constexpr auto LINE_COUNT = 200;
+
+    std::string content;
+
+    for (int i = 0; i < LINE_COUNT; ++i) {
+        content += "{\"name\": \"n" + std::to_string(i) + "\", \"tags\": [\"t" + std::to_string(i) + "\"]}\n";
+    }
+
+    serz::jsonl_parallel_opts opts;
+    opts.thread_count = 4;
+    opts.chunk_size = 256;
+    opts.max_pending_chunks = 3;
+
+    std::istringstream istr(content);
+    int index = 0;
+
+    // str_ref values are checked within the call, while the chunk buffer is still alive
+    auto parse_res = parse_from_jsonl_stream_parallel<Y>(istr, [&index](Y &&y) {
+        REQUIRE(("n" + std::to_string(index)) == y.name.to_string());
+        REQUIRE(1 == y.tags.size());
+        REQUIRE(("t" + std::to_string(index)) == y.tags[0].to_string());
+        ++index;
+    }, opts);
+
+    REQUIRE(parse_res.is_ok());
+    REQUIRE(LINE_COUNT == move(parse_res).unwrap_unchecked());
+    REQUIRE(LINE_COUNT == index);
+}
+
+TEST_CASE("Parse X array elements one at a time", "[parse_X_array]") {
+    static constexpr auto CONTENT = "{"
+        "\"meta\": {\"items\": [0]},"
+        "\"data\": {\"skip\": [{}, 1], \"items\": ["
+        "{\"x\": 1, \"y\": 0.5, \"z\": \"a\", \"a\": true},"
+        "{\"x\": 2, \"y\": 1.5, \"z\": \"b\", \"a\": false}"
+        "]}"
+        "}";
+
+    std::vector<X> xs;
+
+    auto parse_res = parse_from_json_array_content<X>(CONTENT, [&xs](X &&x) {
+        xs.push_back(move(x));
+    }, { "data", "items" });
+
+    REQUIRE(parse_res.is_ok());
+    REQUIRE(2 == move(parse_res).unwrap_unchecked());
+    REQUIRE(2 == xs.size());
+    REQUIRE(1 == xs[0].x);
+    REQUIRE("b" == xs[1].z);
+
+    REQUIRE(parse_from_json_array_content<X>(CONTENT, [](X &&) {}, { "data", "none" }).is_err());
+    REQUIRE(parse_from_json_array_content<X>(CONTENT, [](X &&) {}).is_err());
+}
+
+TEST_CASE("Parse JSON lazily", "[parse_json_lazy]") {
+    static constexpr auto CONTENT = "{\"x\":1,\"y\":{\"z\":[true,\"a\\\"]\"]},\"w\":[{},[]],\"v\":\"}\"}";
+
+    auto parse_res = parse_json_lazy(CONTENT);
+    REQUIRE(parse_res.is_ok());
+
+    const auto val = move(parse_res).unwrap_unchecked();
+    REQUIRE(val.is_lazy());
+    REQUIRE(serz::dom_val_type::obj_type == val.get_type());
+
+    const auto &obj = val.get_unchecked<serz::dom_obj>();
+    REQUIRE(!val.is_lazy());
+    REQUIRE(4 == obj.size());
+    REQUIRE(obj.find("y")->second.is_lazy());
+    REQUIRE(obj.find("w")->second.is_lazy());
+    REQUIRE("}" == obj.find("v")->second.get_unchecked<serz::dom_str>());
+
+    REQUIRE(CONTENT == serialize_json(val, serz::json_format::compact));
+    REQUIRE(!obj.find("y")->second.is_lazy());
+
+    auto x_res = parse_from_json_content_lazy_and_ret<X>(
+        "{\"x\": 7, \"y\": 0.5, \"z\": \"a\", \"a\": true, \"b\": {\"c\": [1, 2]}}");
+
+    REQUIRE(x_res.is_ok());
+    REQUIRE(7 == move(x_res).unwrap_unchecked().x);
+
+    REQUIRE(parse_json_lazy("{\"x\": [1, }").is_err());
+
+    // copies sharing lazy values may be read on different threads
+    const auto shared_val = parse_json_lazy("{\"a\": {\"b\": [1, 2, 3]}}").unwrap_unchecked();
+    const auto &shared_a = shared_val.get_unchecked<serz::dom_obj>().find("a")->second;
+    REQUIRE(shared_a.is_lazy());
+
+    std::atomic<int> read_count(0);
+    std::vector<std::thread> readers;
+
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([copy = shared_val, &read_count] {
+            const auto &b = copy.get_unchecked<serz::dom_obj>().find("a")->second
+                .get_unchecked<serz::dom_obj>().find("b")->second;
+
+            if (3 == b.get_unchecked<serz::dom_arr>().size()) {
+                ++read_count;
+            }
+        });
+    }
+
+    for (auto &reader : readers) {
+        reader.join();
+    }
+
+    REQUIRE(4 == read_count);
+    REQUIRE(!shared_a.is_lazy());
+}
+
+TEST_CASE("Parse JSON error details", "[parse_json_error]") {
+    const auto content = "{\n  \"x\": 1,\n  \"y\": ]\n}" + string(1000, ' ');
+
+    auto parse_res = parse_json_detailed(content);
+    REQUIRE(parse_res.is_err());
+
+    parse_res.match_err([](const serz::json_parse_error &err) {
+        REQUIRE(rapidjson::kParseErrorValueInvalid == err.code);
+        REQUIRE(19 == err.offset);
+        REQUIRE(3 == err.line);
+        REQUIRE(8 == err.column);
+        REQUIRE(err.excerpt.find("\"y\": ]") != string::npos);
+        REQUIRE(err.excerpt.size() <= 64);
+    });
+
+    parse_json(content).match_err([](const string &err_msg) {
+        REQUIRE(err_msg.find("line 3, column 8") != string::npos);
+        REQUIRE(err_msg.size() < 200);
+    });
+}
+
+TEST_CASE("Visit dom_val", "[dom_val_visit]") {
+    struct type_name_visitor {
+        auto operator()(const serz::dom_obj &) const -> string { return "obj"; }
+        auto operator()(const serz::dom_arr &) const -> string { return "arr"; }
+        auto operator()(const serz::dom_bln) const -> string { return "bln"; }
+        auto operator()(const serz::dom_int) const -> string { return "int"; }
+        auto operator()(const serz::dom_flt) const -> string { return "flt"; }
+        auto operator()(const serz::dom_str &) const -> string { return "str"; }
+        auto operator()(const serz::dom_null) const -> string { return "null"; }
+        auto operator()(const serz::dom_null_str_obj) const -> string { return "nso"; }
+    };
+
+    REQUIRE("obj" == serz::dom_val(serz::dom_obj()).visit(type_name_visitor()));
+    REQUIRE("arr" == serz::dom_val(serz::dom_arr()).visit(type_name_visitor()));
+    REQUIRE("int" == serz::dom_val(serz::dom_int(1)).visit(type_name_visitor()));
+    REQUIRE("str" == serz::dom_val(serz::dom_str("a")).visit(type_name_visitor()));
+    REQUIRE("null" == serz::dom_val().visit(type_name_visitor()));
+    REQUIRE(serz::dom_val_type::flt_type == serz::dom_val(0.5).get_type());
+    REQUIRE(serz::dom_val_type::null_string_obj_type == serz::dom_val(serz::dom_null_str_obj()).get_type());
+
+    serz::dom_val val(serz::dom_int(1));
+    val.visit([](auto &inner) -> void { inner = std::decay_t<decltype(inner)>(); });
+    REQUIRE(0 == val.get_unchecked<serz::dom_int>());
+}
+
+TEST_CASE("Move DOM values", "[dom_val_move]") {
+    serz::dom_str str(64, 's');
+    const auto str_buf = str.data();
+    const serz::dom_val str_val(std::move(str));
+    REQUIRE(str_buf == str_val.get_unchecked<serz::dom_str>().data());
+
+    serz::dom_arr arr(3);
+    const auto arr_buf = arr.data();
+    serz::dom_val arr_val;
+    arr_val = std::move(arr);
+    REQUIRE(arr_buf == arr_val.get_unchecked<serz::dom_arr>().data());
+
+    std::vector<const char *> bufs;
+    const std::vector<Z> zs(3, Z{64, &bufs});
+
+    serz::dom_val zs_val;
+    serz::serialize_value(zs, zs_val);
+
+    const auto &zs_arr = zs_val.get_unchecked<serz::dom_arr>();
+    REQUIRE(3 == zs_arr.size());
+
+    for (size_t i = 0; i < zs_arr.size(); ++i) {
+        REQUIRE(bufs[i] == zs_arr[i].get_unchecked<serz::dom_str>().data());
+    }
+}
+
+TEST_CASE("Count copies through JSON", "[copy_count]") {
+    C::copy_count = 0;
+    C::move_count = 0;
+
+    std::vector<C> cs(3);
+
+    for (size_t i = 0; i < cs.size(); ++i) {
+        cs[i].name = string(32, static_cast<char>('a' + i));
+        cs[i].vals.assign(i + 1, static_cast<int>(i));
+    }
+
+    const auto content = serz::serialize_into_json_content(cs, serz::json_format::compact);
+
+    std::vector<C> parsed_cs;
+    REQUIRE(serz::parse_from_json_content(parsed_cs, content).is_ok());
+    REQUIRE(3 == parsed_cs.size());
+    REQUIRE(cs[2].name == parsed_cs[2].name);
+    REQUIRE(cs[2].vals == parsed_cs[2].vals);
+
+    std::vector<C> sax_cs;
+    REQUIRE(serz::parse_from_json_content_sax(sax_cs, content).is_ok());
+    REQUIRE(3 == sax_cs.size());
+
+    std::unordered_map<string, C> cmap;
+    REQUIRE(serz::parse_from_json_content(cmap, R"({"a": {"name": "x", "vals": [1]}})").is_ok());
+    REQUIRE("x" == cmap.at("a").name);
+
+    rustfp::Option<C> oc;
+    REQUIRE(serz::parse_from_json_content(oc, R"({"name": "y", "vals": []})").is_ok());
+    REQUIRE("y" == oc.get_unchecked().name);
+
+    // values are only ever moved along the way
+    REQUIRE(0 == C::copy_count);
+}
+
+TEST_CASE("Compact dom_val", "[dom_val_compact]") {
+    REQUIRE(sizeof(serz::dom_val) <= 16);
+
+    serz::dom_val attr_val(serz::dom_int(1), true);
+    attr_val = serz::dom_str("a");
+    REQUIRE(attr_val.is_attribute());
+    REQUIRE(attr_val.is<serz::dom_str>());
+
+    serz::dom_arr arr(2);
+    arr[0] = serz::dom_str("first");
+    serz::dom_val val(std::move(arr));
+
+    serz::dom_val copy_val(val);
+    copy_val.get_unchecked<serz::dom_arr>()[0] = serz::dom_null();
+    REQUIRE(val.get_unchecked<serz::dom_arr>()[0].is<serz::dom_str>());
+
+    // assigning from a value owned by the target itself
+    val = std::move(val.get_unchecked<serz::dom_arr>()[0]);
+    REQUIRE("first" == val.get_unchecked<serz::dom_str>());
+
+    const auto &same_val = val;
+    val = same_val;
+    REQUIRE("first" == val.get_unchecked<serz::dom_str>());
+}
+
+TEST_CASE("Share dom_val copies", "[dom_val_cow]") {
+    serz::dom_obj inner;
+    inner.emplace("name", serz::dom_val(serz::dom_str("inner")));
+
+    serz::dom_obj outer;
+    outer.emplace("inner", serz::dom_val(std::move(inner)));
+    outer.emplace("other", serz::dom_val(serz::dom_arr(3)));
+
+    const serz::dom_val val(std::move(outer));
+    serz::dom_val copy_val(val);
+
+    const auto &const_copy_val = copy_val;
+    REQUIRE(&val.get_unchecked<serz::dom_obj>() == &const_copy_val.get_unchecked<serz::dom_obj>());
+
+    // only the modified path is cloned
+    auto &copy_inner = copy_val.get_unchecked<serz::dom_obj>().find("inner")->second;
+    copy_inner.get_unchecked<serz::dom_obj>().find("name")->second = serz::dom_str("changed");
+
+    const auto &val_obj = val.get_unchecked<serz::dom_obj>();
+    const auto &copy_obj = const_copy_val.get_unchecked<serz::dom_obj>();
+    REQUIRE(&val_obj != &copy_obj);
+    REQUIRE(&val_obj.find("other")->second.get_unchecked<serz::dom_arr>() ==
+        &copy_obj.find("other")->second.get_unchecked<serz::dom_arr>());
+
+    REQUIRE("inner" == val_obj.find("inner")->second.get_unchecked<serz::dom_obj>()
+        .find("name")->second.get_unchecked<serz::dom_str>());
+
+    REQUIRE("changed" == copy_obj.find("inner")->second.get_unchecked<serz::dom_obj>()
+        .find("name")->second.get_unchecked<serz::dom_str>());
+}
+
+TEST_CASE("Find in insert_map", "[insert_map_find]") {
+    serz::insert_map<string, int> imap;
+
+    for (int i = 0; i < 300; ++i) {
+        REQUIRE(imap.emplace(std::to_string(i), i).second);
+    }
+
+    REQUIRE(!imap.emplace("7", -1).second);
+    REQUIRE(7 == imap.find("7")->second);
+
+    // the found iterator continues in insertion order
+    auto it = imap.find("150");
+    REQUIRE(150 == it->second);
+    ++it;
+    REQUIRE("151" == it->first);
+
+    imap.erase(imap.find("100"));
+    REQUIRE(299 == imap.size());
+    REQUIRE(!(imap.find("100") != imap.end()));
+    REQUIRE(101 == imap.find("101")->second);
+    REQUIRE(299 == imap.find("299")->second);
+
+    const auto copy_imap = imap;
+    REQUIRE(200 == copy_imap.find("200")->second);
+
+    int expected = 0;
+
+    for (const auto &pair : copy_imap) {
+        if (expected == 100) {
+            ++expected;
+        }
+
+        REQUIRE(expected == pair.second);
+        ++expected;
+    }
+}
+
+TEST_CASE("Iterate insert_map", "[insert_map_layout]") {
+    serz::insert_map<string, serz::dom_val> imap;
+
+    for (int i = 0; i < 100; ++i) {
+        imap.emplace(std::to_string(i), serz::dom_val(serz::dom_int(i)));
+    }
+
+    // entries are contiguous in insertion order
+    REQUIRE(&*imap.begin() + 99 == &*imap.find("99"));
+
+    imap.erase(imap.begin());
+    REQUIRE("1" == imap.begin()->first);
+    REQUIRE(!(imap.find("0") != imap.end()));
+
+    REQUIRE(imap.emplace("0", serz::dom_val(serz::dom_str("again"))).second);
+    REQUIRE("again" == imap.find("0")->second.get_unchecked<serz::dom_str>());
+
+    serz::dom_int sum = 0;
+
+    for (const auto &pair : imap) {
+        if (pair.second.is<serz::dom_int>()) {
+            sum += pair.second.get_unchecked<serz::dom_int>();
+        }
+    }
+
+    REQUIRE(4950 == sum);
+}
+
+TEST_CASE("Small insert_map", "[insert_map_small]") {
+    serz::insert_map<string, int> imap;
+    const std::vector<string> keys = {"a", "bb", "ab", "ba", "abc", "", "b", "aa", "c"};
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        REQUIRE(imap.emplace(keys[i], static_cast<int>(i)).second);
+        REQUIRE(!imap.emplace(keys[i], -1).second);
+
+        // passes from linear search to the index on the last key
+        for (size_t j = 0; j <= i; ++j) {
+            REQUIRE(static_cast<int>(j) == imap.find(keys[j])->second);
+        }
+    }
+
+    imap.erase(imap.find("bb"));
+    REQUIRE(8 == imap.size());
+    REQUIRE(!(imap.find("bb") != imap.end()));
+    REQUIRE(8 == imap.find("c")->second);
+    REQUIRE(5 == imap.find("")->second);
+}
+
+TEST_CASE("Erase from insert_map", "[insert_map_erase]") {
+    serz::insert_map<string, int> imap;
+
+    for (int i = 0; i < 20; ++i) {
+        imap.emplace(std::to_string(i), i);
+    }
+
+    // erasing then inserting the same key appends it at the back
+    imap.erase(imap.find("3"));
+    REQUIRE(19 == imap.size());
+    REQUIRE(imap.emplace("3", 30).second);
+    REQUIRE(30 == imap.find("3")->second);
+
+    const auto erased_count = imap.erase_if([](const std::pair<string, int> &pair) {
+        return pair.second % 2 == 0;
+    });
+
+    REQUIRE(11 == erased_count);
+    REQUIRE(9 == imap.size());
+
+    std::vector<int> vals;
+
+    for (const auto &pair : imap) {
+        vals.push_back(pair.second);
+    }
+
+    REQUIRE((std::vector<int>{1, 5, 7, 9, 11, 13, 15, 17, 19}) == vals);
+
+    REQUIRE(9 == imap.erase_if([](const std::pair<string, int> &) { return true; }));
+    REQUIRE(imap.empty());
+    REQUIRE(!(imap.begin() != imap.end()));
+
+    // a small map that holds an erased entry searches the new entry safely
+    serz::insert_map<string, int> small_imap{{"a", 1}, {"b", 2}, {"c", 3}, {"d", 4}};
+    small_imap.erase(small_imap.find("b"));
+    REQUIRE(small_imap.emplace("e", 5).second);
+    REQUIRE(!small_imap.emplace(std::make_pair(string("e"), 50)).second);
+    REQUIRE(small_imap.emplace(std::make_pair(string("b"), 20)).second);
+    REQUIRE(5 == small_imap.size());
+    REQUIRE(5 == small_imap.find("e")->second);
+    REQUIRE(20 == small_imap.find("b")->second);
+}
+
+TEST_CASE("Reserve insert_map", "[insert_map_reserve]") {
+    serz::insert_map<string, int> imap;
+    imap.reserve(100);
+    REQUIRE(imap.capacity() >= 100);
+
+    const auto first_entry = &*imap.emplace("0", 0).first;
+
+    for (int i = 1; i < 100; ++i) {
+        imap.emplace(std::to_string(i), i);
+    }
+
+    // reserved entries are not moved by inserting
+    REQUIRE(first_entry == &*imap.begin());
+    REQUIRE(42 == imap.find("42")->second);
+
+    const serz::insert_map<string, int> init_imap = {{"b", 1}, {"a", 2}, {"b", 3}};
+    REQUIRE(2 == init_imap.size());
+    REQUIRE(1 == init_imap.find("b")->second);
+    REQUIRE("b" == init_imap.begin()->first);
+
+    const std::vector<std::pair<string, int>> pairs = {{"x", 1}, {"y", 2}};
+    const serz::insert_map<string, int> range_imap(pairs.cbegin(), pairs.cend());
+    REQUIRE(2 == range_imap.size());
+    REQUIRE(2 == range_imap.find("y")->second);
+
+    // emplacing an existing key neither constructs nor moves the entries
+    serz::insert_map<string, M> full_imap;
+    full_imap.reserve(4);
+
+    for (int i = 0; i < 4; ++i) {
+        full_imap.emplace(std::to_string(i), M());
+    }
+
+    REQUIRE(full_imap.capacity() == full_imap.size());
+
+    const auto full_entry = &*full_imap.begin();
+    M::move_count = 0;
+    REQUIRE(!full_imap.emplace("0", M()).second);
+    REQUIRE(!full_imap.emplace(string("3"), M()).second);
+    REQUIRE(0 == M::move_count);
+    REQUIRE(full_entry == &*full_imap.begin());
+}
+
+TEST_CASE("Find in insert_map by reference", "[insert_map_str_ref]") {
+    serz::insert_map<string, int> small_imap;
+    serz::insert_map<string, int> large_imap;
+
+    for (int i = 0; i < 300; ++i) {
+        if (i < 4) {
+            small_imap.emplace(std::to_string(i), i);
+        }
+
+        large_imap.emplace(std::to_string(i), i);
+    }
+
+    // refers into the middle of a buffer without a null terminator
+    const char buf[] = {'x', '1', '2', '7', 'x'};
+
+    REQUIRE(127 == large_imap.find(serz::str_ref(buf + 1, 3))->second);
+    REQUIRE(12 == large_imap.find(serz::str_ref(buf + 1, 2))->second);
+    REQUIRE(!(large_imap.find(serz::str_ref(buf, 2)) != large_imap.end()));
+    REQUIRE(1 == small_imap.find(serz::str_ref(buf + 1, 1))->second);
+    REQUIRE(!(small_imap.find(serz::str_ref(buf + 1, 2)) != small_imap.end()));
+
+    const char *const key = "299";
+    REQUIRE(299 == large_imap.find(key)->second);
+
+    const auto &const_imap = large_imap;
+    REQUIRE(299 == const_imap.find(serz::str_ref(key))->second);
+
+    // parses with names that are only referenced
+    const string name = "x";
+    int x = 0;
+
+    const auto val = serz::parse_json(R"({"x": 7})").unwrap_unchecked();
+    const auto res = serz::as_obj(val) & serz::parse_nvp(x, name);
+
+    REQUIRE(res.is_ok());
+    REQUIRE(7 == x);
+}
+
+TEST_CASE("Parse and serialize SERZ_FIELDS", "[serz_fields]") {
+    static constexpr auto CONTENT = "{"
+        "\"note\": \"n\","
+        "\"extra\": [1, 2],"
+        "\"vals\": [3, 4, 5],"
+        "\"name\": \"w\","
+        "\"ratio\": 0.25,"
+        "\"id\": 7"
+        "}";
+
+    // every name gets its own slot
+    const auto &hash = serz::details::field_index<W>::hash;
+    REQUIRE(0 == hash.find("id", 2));
+    REQUIRE(4 == hash.find("note", 4));
+    REQUIRE(5 == hash.find("extra", 5));
+    REQUIRE(5 == hash.find("i", 1));
+
+    const auto w = parse_from_json_content_and_ret<W>(CONTENT).unwrap_unchecked();
+    REQUIRE(7 == w.id);
+    REQUIRE(0.25 == w.ratio);
+    REQUIRE("w" == w.name);
+    REQUIRE((std::vector<int>{3, 4, 5}) == w.vals);
+    REQUIRE("n" == w.note.get_unchecked());
+
+    // fields that may be missing are reset in the same way as parse_nvp
+    const auto partial = parse_from_json_content_and_ret<W>(
+        R"({"id": 1, "ratio": 2.0, "name": ""})").unwrap_unchecked();
+
+    REQUIRE(1 == partial.id);
+    REQUIRE(partial.vals.empty());
+    REQUIRE(partial.note.is_none());
+
+    parse_from_json_content_and_ret<W>(R"({"id": 1, "ratio": 2.0})")
+        .match_err([](const string &err_msg) {
+            REQUIRE(string::npos != err_msg.find("'name'"));
+        });
+
+    REQUIRE(parse_from_json_content_and_ret<W>(R"({"id": "1"})").is_err());
+    REQUIRE(parse_from_json_content_and_ret<W>("[]").is_err());
+
+    // serializes in the order of declaration
+    serz::dom_val val;
+    serialize_value(w, val);
+
+    std::vector<string> keys;
+
+    for (const auto &pair : val.get_unchecked<serz::dom_obj>()) {
+        keys.push_back(pair.first);
+    }
+
+    REQUIRE((std::vector<string>{"id", "ratio", "name", "vals", "note"}) == keys);
+
+    const auto rt = parse_from_json_content_and_ret<W>(serialize_json(val)).unwrap_unchecked();
+    REQUIRE(7 == rt.id);
+    REQUIRE((std::vector<int>{3, 4, 5}) == rt.vals);
+
+    // the same table drives SAX parsing
+    const auto sax_w = parse_from_json_content_sax_and_ret<W>(CONTENT).unwrap_unchecked();
+    REQUIRE(7 == sax_w.id);
+    REQUIRE("w" == sax_w.name);
+    REQUIRE((std::vector<int>{3, 4, 5}) == sax_w.vals);
+}
+
+TEST_CASE("Match parse_nvp chain with cursor", "[dom_obj_cursor]") {
+    serz::dom_obj obj;
+
+    for (int i = 0; i < 20; ++i) {
+        obj.emplace(std::to_string(i), serz::dom_val(static_cast<serz::dom_int>(i)));
+    }
+
+    serz::dom_obj_cursor cursor(obj);
+
+    // in order, each name is the member after the previous match
+    for (int i = 0; i < 20; ++i) {
+        const auto it = cursor.find(std::to_string(i));
+        REQUIRE(it != obj.cend());
+        REQUIRE(std::to_string(i) == it->first);
+    }
+
+    // out of order and missing names fall back to the hash lookup
+    REQUIRE("5" == cursor.find("5")->first);
+    REQUIRE(!(cursor.find("20") != obj.cend()));
+    REQUIRE("6" == cursor.find("6")->first);
+    REQUIRE("2" == cursor.find("2")->first);
+
+    const auto val = serz::parse_json(R"({"z": "w", "a": true, "y": 1.5, "x": 3})").unwrap_unchecked();
+    X x;
+
+    REQUIRE(serz::parse_value(x, val).is_ok());
+    REQUIRE(3 == x.x);
+    REQUIRE("w" == x.z);
+}
+
+TEST_CASE("Parse error with path", "[parse_error]") {
+    Book book;
+
+    const auto bad_val = parse_json(R"({"orders": [{"price": 1.5}, {"price": 2.5}, {"price": true}]})").unwrap_unchecked();
+    const auto bad_res = parse_value(book, bad_val);
+    REQUIRE(bad_res.is_err());
+
+    const auto &err = bad_res.get_err_unchecked();
+    REQUIRE(serz::parse_errc::type_mismatch == err.code);
+    REQUIRE(serz::dom_val_type::flt_type == err.expected);
+    REQUIRE(serz::dom_val_type::bool_type == err.actual);
+    REQUIRE("/orders/2/price" == err.path());
+    REQUIRE(string::npos != err.to_string().find("'f64' at '/orders/2/price'"));
+
+    // a parse_nvp chain gives the structured error, or its message for a custom parse_value
+    Order order;
+    const auto order_val = parse_json(R"({"price": true})").unwrap_unchecked();
+
+    const Result<Order &, serz::parse_error> chain_res =
+        serz::as_obj(order_val) & serz::parse_nvp(order.price, "price") & serz::done_obj(order);
+
+    REQUIRE("/price" == chain_res.get_err_unchecked().path());
+
+    const Result<Order &, string> chain_msg_res =
+        serz::as_obj(order_val) & serz::parse_nvp(order.price, "price") & serz::done_obj(order);
+
+    REQUIRE(string::npos != chain_msg_res.get_err_unchecked().find("at '/price'"));
+
+    const auto missing_val = parse_json(R"({"orders": [{"cost": 1.5}]})").unwrap_unchecked();
+    const auto missing_res = parse_value(book, missing_val);
+    REQUIRE(serz::parse_errc::missing_key == missing_res.get_err_unchecked().code);
+    REQUIRE("/orders/0/price" == missing_res.get_err_unchecked().path());
+    REQUIRE(string::npos != missing_res.get_err_unchecked().to_string().find("'price'"));
+
+    // keys are escaped as in JSON pointer
+    std::unordered_map<string, int> imap;
+    const auto map_val = parse_json(R"({"a/b~": true})").unwrap_unchecked();
+    const auto map_res = serz::parse_value(imap, map_val);
+    REQUIRE(serz::parse_errc::type_mismatch == map_res.get_err_unchecked().code);
+    REQUIRE("/a~1b~0" == map_res.get_err_unchecked().path());
+
+    // a plain message is formatted from the provided parse_value
+    std::vector<int> ints;
+    const auto ints_res = serz::parse_ints(ints, parse_json("[1, []]").unwrap_unchecked());
+    REQUIRE(string::npos != ints_res.get_err_unchecked().find("at '/1'"));
+    REQUIRE(serz::parse_ints(ints, parse_json("[1, 2]").unwrap_unchecked()).is_ok());
+
+    // the JSON interfaces still report the formatted message
+    parse_from_json_content_and_ret<Book>(R"({"orders": {"price": []}})")
+        .match_err([](const string &err_msg) {
+            REQUIRE(string::npos != err_msg.find("at '/orders/price'"));
+        });
+}
+
+TEST_CASE("Parse containers in place", "[parse_containers]") {
+    M::parse_count = 0;
+    M::move_count = 0;
+
+    std::vector<M> ms;
+    REQUIRE(serz::parse_value(ms, parse_json("[1, 2, 3, 4]").unwrap_unchecked()).is_ok());
+    REQUIRE(4 == ms.size());
+    REQUIRE(4 == ms.capacity());
+    REQUIRE(3 == ms[2].val);
+    REQUIRE(0 == M::move_count);
+
+    // stops at the first element that fails
+    M::parse_count = 0;
+    std::vector<M> bad_ms;
+    const auto bad_res = serz::parse_value(bad_ms, parse_json("[1, 2, true, 4, 5]").unwrap_unchecked());
+    REQUIRE(bad_res.is_err());
+    REQUIRE("/2" == bad_res.get_err_unchecked().path());
+    REQUIRE(3 == M::parse_count);
+    REQUIRE(2 == bad_ms.size());
+
+    M::parse_count = 0;
+    std::unordered_map<string, M> mmap;
+    const auto map_res = serz::parse_value(mmap, parse_json(R"({"a": 1, "b": true, "c": 3})").unwrap_unchecked());
+    REQUIRE(map_res.is_err());
+    REQUIRE("/b" == map_res.get_err_unchecked().path());
+    REQUIRE(2 == M::parse_count);
+    REQUIRE(1 == mmap.size());
+    REQUIRE(1 == mmap.at("a").val);
+    REQUIRE(0 == M::move_count);
+
+    rustfp::Option<M> om;
+    REQUIRE(serz::parse_value(om, parse_json("7").unwrap_unchecked()).is_ok());
+    REQUIRE(7 == om.get_unchecked().val);
+    REQUIRE(serz::parse_value(om, parse_json("[]").unwrap_unchecked()).is_err());
+    REQUIRE(7 == om.get_unchecked().val);
+
+    // the storage of the option is kept on failure by reuse
+    rustfp::Option<std::vector<int>> oints = rustfp::Some(std::vector<int>{1, 2, 3});
+    const auto oints_data = oints.get_unchecked().data();
+
+    {
+        serz::parse_mode_scope scope(serz::parse_mode::reuse);
+        REQUIRE(serz::parse_value(oints, parse_json("[4, true, 6]").unwrap_unchecked()).is_err());
+    }
+
+    REQUIRE(oints.is_some());
+    REQUIRE(oints_data == oints.get_unchecked().data());
+    REQUIRE(4 == oints.get_unchecked()[0]);
+
+    std::vector<bool> bs;
+    REQUIRE(serz::parse_value(bs, parse_json("[true, false]").unwrap_unchecked()).is_ok());
+    REQUIRE((std::vector<bool>{true, false}) == bs);
+}
+
+TEST_CASE("Parse into existing objects by reuse", "[parse_mode]") {
+    REQUIRE(serz::parse_mode::append == serz::get_parse_mode());
+
+    std::vector<string> strs;
+    strs.reserve(8);
+    strs.emplace_back(64, 'x');
+    strs.emplace_back(64, 'y');
+    strs.emplace_back(64, 'z');
+    const auto strs_data = strs.data();
+    const auto str_data = strs[0].data();
+
+    std::unordered_map<string, std::vector<int>> vmap;
+    vmap["a"] = {1, 2, 3, 4};
+    vmap["stale"] = {5};
+    const auto vmap_data = vmap["a"].data();
+
+    rustfp::Option<string> ostr = rustfp::Some(string(64, 'o'));
+    const auto ostr_data = ostr.get_unchecked().data();
+
+    {
+        serz::parse_mode_scope reuse(serz::parse_mode::reuse);
+        REQUIRE(serz::parse_mode::reuse == serz::get_parse_mode());
+
+        // resized to the incoming size, parsing into the existing storage
+        REQUIRE(serz::parse_value(strs, parse_json(R"(["p", "q"])").unwrap_unchecked()).is_ok());
+        REQUIRE((std::vector<string>{"p", "q"}) == strs);
+        REQUIRE(strs_data == strs.data());
+        REQUIRE(str_data == strs[0].data());
+
+        REQUIRE(serz::parse_value(vmap, parse_json(R"({"a": [7, 8], "b": [9]})").unwrap_unchecked()).is_ok());
+        REQUIRE(2 == vmap.size());
+        REQUIRE((std::vector<int>{7, 8}) == vmap.at("a"));
+        REQUIRE((std::vector<int>{9}) == vmap.at("b"));
+        REQUIRE(vmap_data == vmap.at("a").data());
+
+        REQUIRE(serz::parse_value(ostr, parse_json(R"("v")").unwrap_unchecked()).is_ok());
+        REQUIRE("v" == ostr.get_unchecked());
+        REQUIRE(ostr_data == ostr.get_unchecked().data());
+
+        // a single value is kept as the first element
+        REQUIRE(serz::parse_value(strs, parse_json(R"("s")").unwrap_unchecked()).is_ok());
+        REQUIRE((std::vector<string>{"s"}) == strs);
+        REQUIRE(str_data == strs[0].data());
+
+        // the same holds when parsing through the SAX interface
+        W w;
+        w.vals.reserve(8);
+        w.name.assign(64, 'n');
+        const auto vals_data = w.vals.data();
+        const auto name_data = w.name.data();
+
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(serz::parse_from_json_content_sax(w,
+                R"({"id": 1, "ratio": 0.5, "name": "w", "vals": [1, 2, 3], "note": "m"})").is_ok());
+
+            REQUIRE((std::vector<int>{1, 2, 3}) == w.vals);
+            REQUIRE("w" == w.name);
+            REQUIRE("m" == w.note.get_unchecked());
+            REQUIRE(vals_data == w.vals.data());
+            REQUIRE(name_data == w.name.data());
+        }
+
+        std::unordered_map<string, int> imap{{"x", 1}, {"y", 2}};
+        REQUIRE(serz::parse_from_json_content_sax(imap, R"({"y": 3, "z": 4})").is_ok());
+        REQUIRE((std::unordered_map<string, int>{{"y", 3}, {"z", 4}}) == imap);
+
+        std::vector<int> ivec{1, 2, 3, 4};
+        REQUIRE(serz::parse_from_json_content_sax(ivec, "[5, 6]").is_ok());
+        REQUIRE((std::vector<int>{5, 6}) == ivec);
+    }
+
+    // appends again outside of the scope
+    REQUIRE(serz::parse_mode::append == serz::get_parse_mode());
+    REQUIRE(serz::parse_value(strs, parse_json(R"(["t"])").unwrap_unchecked()).is_ok());
+    REQUIRE((std::vector<string>{"s", "t"}) == strs);
+}